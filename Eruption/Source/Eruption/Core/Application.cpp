@@ -3,6 +3,13 @@
 #include "Eruption/Core/Input.h"
 #include "Eruption/Core/Timer.h"
 
+#include "Eruption/Debug/MemoryTracker.h"
+#include "Eruption/Debug/Metrics.h"
+#include "Eruption/Debug/Profiler.h"
+#include "Eruption/Debug/Telemetry.h"
+
+#include "Eruption/Platform/Vulkan/VulkanCallCounters.h"
+
 #include "Eruption/Renderer/Renderer.h"
 
 #include <glm/ext/scalar_common.hpp>
@@ -13,7 +20,11 @@ namespace Eruption
 
 	Application::Application(const ApplicationSpecification& specification) : m_Specification(specification)
 	{
-		Log::Init();
+		Log::Init(specification.Logging);
+		Profiler::SetThreadName("Main");
+
+		if (specification.LiveTelemetry.Enabled)
+			Telemetry::Open(specification.LiveTelemetry);
 
 		s_Instance = this;
 
@@ -38,10 +49,21 @@ namespace Eruption
 		else
 			m_Window->CenterWindow();
 		m_Window->SetResizable(specification.Resizable);
+
+		if (specification.Watchdog.Enabled)
+			m_FrameWatchdog = CreateScope<FrameWatchdog>(specification.Watchdog);
+
+		if (specification.MetricsPublishing.Publish)
+			Metrics::StartPublishing(specification.MetricsPublishing);
 	}
 
 	Application::~Application()
 	{
+		// Waits for a capture still being written, which logs its result
+		m_FrameWatchdog.reset();
+		Metrics::StopPublishing();
+		Telemetry::Close();
+
 		Log::Shutdown();
 	}
 
@@ -53,20 +75,39 @@ namespace Eruption
 		{
 			static uint64_t s_FrameCounter = 0;
 
+			static MetricCounter&   s_Frames    = Metrics::GetCounter("eruption_frames_total");
+			static MetricHistogram& s_FrameTime = Metrics::GetHistogram("eruption_frame_time_microseconds");
+			static MetricHistogram& s_CpuTime   = Metrics::GetHistogram("eruption_frame_cpu_time_microseconds");
+
+			ER_PROFILE_FRAME();
+
 			ProcessEvents();
 
+			float cpuTimeMs = 0.0f;
 			if (!m_Minimized)
 			{
 				Timer cpuTimer;
 
+				const Ref<RendererContext> rendererContext = m_Window->GetRendererContext();
+				if (rendererContext)
+					rendererContext->BeginFrame(m_CurrentFrameIndex);
+
 				HandledQueuedEvents();
 
-				for (Layer* layer : m_LayerStack)
 				{
-					if (layer->IsEnabled())
-						layer->OnUpdate(m_DeltaTime);
+					ER_PROFILE_SCOPE("Application::UpdateLayers");
+					for (Layer* layer : m_LayerStack)
+					{
+						if (layer->IsEnabled())
+							layer->OnUpdate(m_DeltaTime);
+					}
 				}
 
+				if (rendererContext)
+					rendererContext->EndFrame();
+
+				cpuTimeMs = cpuTimer.ElapsedMillis();
+
 				m_Window->SwapBuffers();
 
 				m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % Renderer::GetConfig().FramesInFlight;
@@ -80,6 +121,25 @@ namespace Eruption
 			m_LastFrameTime  = time;
 
 			++s_FrameCounter;
+
+			MemoryTracker::MarkFrame();
+			VulkanCallCounters::MarkFrame();
+			if (m_FrameWatchdog)
+				m_FrameWatchdog->EndFrame(cpuTimeMs);
+
+			s_Frames.Increment();
+			s_FrameTime.Record(static_cast<uint64_t>(std::max(m_FrameTime.GetMilliseconds(), 0.0f) * 1000.0f));
+			s_CpuTime.Record(static_cast<uint64_t>(cpuTimeMs * 1000.0f));
+			Metrics::MarkFrame();
+
+			if constexpr (MemoryTracker::IsEnabled())
+			{
+				static MetricGauge& s_HeapLiveBytes = Metrics::GetGauge("eruption_heap_live_bytes", "Live heap bytes");
+				s_HeapLiveBytes.Set(MemoryTracker::GetLastFrameStats().LiveBytes);
+			}
+
+			if (Telemetry::IsOpen())
+				PublishTelemetry(s_FrameCounter, cpuTimeMs);
 		}
 
 		OnShutdown();
@@ -95,6 +155,8 @@ namespace Eruption
 
 	void Application::ProcessEvents() const
 	{
+		ER_PROFILE_FUNCTION();
+
 		Input::TransitionPressedKeys();
 		Input::TransitionPressedButtons();
 
@@ -102,9 +164,30 @@ namespace Eruption
 	}
 	void Application::HandledQueuedEvents()
 	{
+		ER_PROFILE_FUNCTION();
+
 		m_EventBus.ProcessQueue();
 	}
 
+	void Application::PublishTelemetry(uint64_t frameIndex, float cpuTimeMs) const
+	{
+		static MetricGauge& s_GpuLiveBytes = Metrics::GetGauge("eruption_gpu_memory_live_bytes");
+
+		const MemoryFrameStats heap = MemoryTracker::GetLastFrameStats();
+
+		Telemetry::PublishFrame(
+		    {.FrameIndex      = frameIndex,
+		     .FrameTimeNs     = static_cast<int64_t>(static_cast<double>(m_FrameTime.GetSeconds()) * 1e9),
+		     .CpuTimeNs       = static_cast<int64_t>(static_cast<double>(cpuTimeMs) * 1e6),
+		     .HeapLiveBytes   = heap.LiveBytes,
+		     .HeapAllocations = heap.Allocations,
+		     .GpuLiveBytes    = s_GpuLiveBytes.GetValue()}
+		);
+
+		if (const Ref<RendererContext> context = m_Window->GetRendererContext())
+			context->PublishTelemetry();
+	}
+
 	float Application::GetTime()
 	{
 		return static_cast<float>(glfwGetTime());
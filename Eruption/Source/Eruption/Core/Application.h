@@ -6,6 +6,10 @@
 #include "Eruption/Core/LayerStack.h"
 #include "Eruption/Core/Window.h"
 
+#include "Eruption/Debug/FrameWatchdog.h"
+#include "Eruption/Debug/Metrics.h"
+#include "Eruption/Debug/Telemetry.h"
+
 #include <string>
 
 namespace Eruption
@@ -21,6 +25,11 @@ namespace Eruption
 		bool        Resizable      = true;
 		bool        StartMaximized = false;
 		bool        VSync          = true;
+
+		LogSpecification           Logging;
+		FrameWatchdogSpecification Watchdog;
+		MetricsSpecification       MetricsPublishing;
+		TelemetrySpecification     LiveTelemetry;
 	};
 
 	class Application
@@ -50,6 +59,9 @@ namespace Eruption
 
 		[[nodiscard]] Window& GetWindow() const { return *m_Window; }
 
+		// Null when disabled in the specification
+		[[nodiscard]] FrameWatchdog* GetFrameWatchdog() const { return m_FrameWatchdog.get(); }
+
 		[[nodiscard]] DeltaTime GetDeltaTime() const { return m_DeltaTime; }
 		[[nodiscard]] DeltaTime GetFrameTime() const { return m_FrameTime; }
 
@@ -62,6 +74,7 @@ namespace Eruption
 	private:
 		void ProcessEvents() const;
 		void HandledQueuedEvents();
+		void PublishTelemetry(uint64_t frameIndex, float cpuTimeMs) const;
 
 		bool OnWindowResize(WindowResizeEvent& e);
 		bool OnWindowMinimize(WindowMinimizeEvent& e);
@@ -75,6 +88,7 @@ namespace Eruption
 		LayerStack m_LayerStack;
 
 		std::unique_ptr<Window> m_Window;
+		Scope<FrameWatchdog>    m_FrameWatchdog;
 
 		DeltaTime m_DeltaTime;
 		DeltaTime m_FrameTime;
@@ -0,0 +1,225 @@
+#include "AsyncLogBackend.h"
+
+#include "Eruption/Debug/Profiler.h"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/os.h>
+#include <spdlog/sinks/sink.h>
+
+namespace Eruption
+{
+	namespace
+	{
+		// Queue records carrying this level only request a flush and have no message
+		constexpr spdlog::level::level_enum FLUSH_REQUEST_LEVEL = spdlog::level::off;
+	}        // namespace
+
+	AsyncLogBackend::AsyncLogBackend(std::shared_ptr<spdlog::logger> logger, const LogSpecification& specification) :
+	    m_Logger(std::move(logger)),
+	    m_Queue(specification.QueueCapacity),
+	    m_OverflowPolicy(specification.OverflowPolicy)
+	{
+		m_Worker = std::thread([this] { WorkerLoop(); });
+	}
+
+	AsyncLogBackend::~AsyncLogBackend()
+	{
+		m_Running.store(false, std::memory_order_release);
+		WakeWorker();
+
+		if (m_Worker.joinable())
+			m_Worker.join();
+	}
+
+	void AsyncLogBackend::Push(Log::Level level, std::string_view message)
+	{
+		const spdlog::level::level_enum spdlogLevel = Log::ToSpdlogLevel(level);
+
+		if (level == Log::Level::Fatal)
+		{
+			std::atomic<bool> delivered = false;
+			PushBlocking(spdlogLevel, message, &delivered);
+			delivered.wait(false, std::memory_order_acquire);
+			return;
+		}
+
+		switch (m_OverflowPolicy)
+		{
+			case LogOverflowPolicy::Block:
+			{
+				PushBlocking(spdlogLevel, message, nullptr);
+				return;
+			}
+			case LogOverflowPolicy::DropOldest:
+			{
+				while (!TryPush(spdlogLevel, message, nullptr))
+				{
+					m_Queue.TryPop([this](Record& record) {
+						// Fatal messages and flush requests must still reach the sinks, but only the worker may
+						// deliver them or they could overtake the records it is still writing
+						if (record.Delivered)
+						{
+							HandOff(record);
+							return;
+						}
+
+						m_PendingDropped.fetch_add(1, std::memory_order_relaxed);
+						m_TotalDropped.fetch_add(1, std::memory_order_relaxed);
+					});
+				}
+				return;
+			}
+			case LogOverflowPolicy::DropNewest:
+			{
+				if (!TryPush(spdlogLevel, message, nullptr))
+				{
+					m_PendingDropped.fetch_add(1, std::memory_order_relaxed);
+					m_TotalDropped.fetch_add(1, std::memory_order_relaxed);
+				}
+				return;
+			}
+		}
+	}
+
+	void AsyncLogBackend::Flush()
+	{
+		std::atomic<bool> delivered = false;
+		PushBlocking(FLUSH_REQUEST_LEVEL, {}, &delivered);
+		delivered.wait(false, std::memory_order_acquire);
+	}
+
+	bool AsyncLogBackend::TryPush(
+	    spdlog::level::level_enum level, std::string_view message, std::atomic<bool>* delivered
+	)
+	{
+		const bool pushed = m_Queue.TryPush([&](Record& record) {
+			record.Level    = level;
+			record.Time     = spdlog::log_clock::now();
+			record.ThreadID = spdlog::details::os::thread_id();
+			record.Message.assign(message);        // Reuses the capacity the cell already owns
+			record.Delivered = delivered;
+		});
+
+		if (pushed)
+			WakeWorker();
+
+		return pushed;
+	}
+
+	void AsyncLogBackend::PushBlocking(
+	    spdlog::level::level_enum level, std::string_view message, std::atomic<bool>* delivered
+	)
+	{
+		while (!TryPush(level, message, delivered))
+		{
+			WakeWorker();
+			std::this_thread::yield();
+		}
+	}
+
+	void AsyncLogBackend::Deliver(Record& record) const
+	{
+		if (record.Level != FLUSH_REQUEST_LEVEL)
+		{
+			spdlog::details::log_msg message(record.Time, {}, m_Logger->name(), record.Level, record.Message);
+			message.thread_id = record.ThreadID;
+
+			for (const spdlog::sink_ptr& sink : m_Logger->sinks())
+			{
+				if (sink->should_log(message.level))
+					sink->log(message);
+			}
+		}
+
+		if (record.Delivered)
+		{
+			for (const spdlog::sink_ptr& sink : m_Logger->sinks())
+				sink->flush();
+
+			record.Delivered->store(true, std::memory_order_release);
+			record.Delivered->notify_all();
+			record.Delivered = nullptr;
+		}
+	}
+
+	void AsyncLogBackend::ReportDropped() const
+	{
+		const uint64_t dropped = m_PendingDropped.exchange(0, std::memory_order_relaxed);
+		if (dropped == 0)
+			return;
+
+		const std::string text = std::format("[Log] Queue overflow, dropped {0} messages", dropped);
+
+		const spdlog::details::log_msg message(m_Logger->name(), spdlog::level::warn, text);
+		for (const spdlog::sink_ptr& sink : m_Logger->sinks())
+		{
+			if (sink->should_log(message.level))
+				sink->log(message);
+		}
+	}
+
+	void AsyncLogBackend::HandOff(Record& record)
+	{
+		{
+			std::lock_guard lock(m_HandOffMutex);
+			m_HandedOff.push_back(std::move(record));
+			record.Delivered = nullptr;
+			m_HasHandedOff.store(true, std::memory_order_release);
+		}
+
+		WakeWorker();
+	}
+
+	void AsyncLogBackend::DeliverHandedOff()
+	{
+		if (!m_HasHandedOff.load(std::memory_order_acquire))
+			return;
+
+		std::vector<Record> records;
+		{
+			std::lock_guard lock(m_HandOffMutex);
+			records.swap(m_HandedOff);
+			m_HasHandedOff.store(false, std::memory_order_relaxed);
+		}
+
+		for (Record& record : records)
+			Deliver(record);
+	}
+
+	void AsyncLogBackend::WakeWorker()
+	{
+		m_WakeSignal.fetch_add(1, std::memory_order_release);
+		m_WakeSignal.notify_one();
+	}
+
+	void AsyncLogBackend::WorkerLoop()
+	{
+		Profiler::SetThreadName("Log");
+
+		// Handed off records are delivered between pops, after the records popped before them
+		const auto drain = [this] {
+			do
+				DeliverHandedOff();
+			while (m_Queue.TryPop([this](Record& record) { Deliver(record); }));
+			ReportDropped();
+		};
+
+		while (m_Running.load(std::memory_order_acquire))
+		{
+			// Read the signal before draining so a push racing with the drain still wakes us up
+			const uint32_t signal = m_WakeSignal.load(std::memory_order_acquire);
+
+			drain();
+
+			if (!m_Running.load(std::memory_order_acquire))
+				break;
+
+			m_WakeSignal.wait(signal, std::memory_order_acquire);
+		}
+
+		drain();
+
+		for (const spdlog::sink_ptr& sink : m_Logger->sinks())
+			sink->flush();
+	}
+}        // namespace Eruption
@@ -0,0 +1,80 @@
+#pragma once
+#include "Eruption/Core/BoundedMPMCQueue.h"
+#include "Eruption/Core/Log.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Eruption
+{
+	// Moves sink I/O off the calling thread: producers copy the formatted message into a
+	// preallocated queue cell and a background thread writes it to the logger's sinks.
+	class AsyncLogBackend
+	{
+	public:
+		AsyncLogBackend(std::shared_ptr<spdlog::logger> logger, const LogSpecification& specification);
+		~AsyncLogBackend();
+
+		AsyncLogBackend(const AsyncLogBackend&)            = delete;
+		AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+		AsyncLogBackend(AsyncLogBackend&&)                 = delete;
+		AsyncLogBackend& operator=(AsyncLogBackend&&)      = delete;
+
+		// Fatal messages are never dropped and return only once they reached the sinks
+		void Push(Log::Level level, std::string_view message);
+
+		// Blocks until everything pushed before the call is written and the sinks are flushed
+		void Flush();
+
+		[[nodiscard]] uint64_t GetDroppedCount() const { return m_TotalDropped.load(std::memory_order_relaxed); }
+
+	private:
+		struct Record
+		{
+			spdlog::level::level_enum     Level = spdlog::level::trace;
+			spdlog::log_clock::time_point Time;
+			size_t                        ThreadID = 0;
+			std::string                   Message;
+
+			// Set for fatal messages and flush requests; signalled once the record is delivered
+			std::atomic<bool>* Delivered = nullptr;
+		};
+
+	private:
+		bool TryPush(spdlog::level::level_enum level, std::string_view message, std::atomic<bool>* delivered);
+		void PushBlocking(spdlog::level::level_enum level, std::string_view message, std::atomic<bool>* delivered);
+
+		void Deliver(Record& record) const;
+		void ReportDropped() const;
+
+		// Fatal messages and flush requests popped by a producer making room are handed to the worker, which
+		// delivers them after the records it popped before them
+		void HandOff(Record& record);
+		void DeliverHandedOff();
+
+		void WakeWorker();
+		void WorkerLoop();
+
+	private:
+		std::shared_ptr<spdlog::logger> m_Logger;
+		BoundedMPMCQueue<Record>        m_Queue;
+		LogOverflowPolicy               m_OverflowPolicy;
+
+		mutable std::atomic<uint64_t> m_PendingDropped = 0;
+		std::atomic<uint64_t>         m_TotalDropped   = 0;
+
+		std::mutex          m_HandOffMutex;
+		std::vector<Record> m_HandedOff;
+		std::atomic<bool>   m_HasHandedOff = false;
+
+		std::atomic<uint32_t> m_WakeSignal = 0;
+		std::atomic<bool>     m_Running    = true;
+
+		std::thread m_Worker;
+	};
+}        // namespace Eruption
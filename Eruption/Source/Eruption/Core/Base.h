@@ -1,4 +1,6 @@
 #pragma once
+#include "Eruption/Debug/MemoryTracker.h"
+
 #include <memory>
 
 #if !defined(ER_PLATFORM_WINDOWS) && !defined(ER_PLATFORM_LINUX)
@@ -15,6 +17,9 @@ namespace Eruption
 	template <typename T, typename... Args>
 	constexpr Scope<T> CreateScope(Args&&... args)
 	{
+#ifdef ER_ENABLE_MEMORY_TRACKING
+		MemoryTypeScope typeScope(GetMemoryTypeTag<T>());
+#endif
 		return std::make_unique<T>(std::forward<Args>(args)...);
 	}
 
@@ -30,6 +35,9 @@ namespace Eruption
 	template <typename T, typename... Args>
 	constexpr Ref<T> CreateRef(Args&&... args)
 	{
+#ifdef ER_ENABLE_MEMORY_TRACKING
+		MemoryTypeScope typeScope(GetMemoryTypeTag<T>());
+#endif
 		return std::make_shared<T>(std::forward<Args>(args)...);
 	}
 
@@ -0,0 +1,242 @@
+#include "BinaryLog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+namespace Eruption
+{
+	namespace
+	{
+		// Chunks are appended to the file once a thread's buffer grows past this size
+		constexpr size_t THREAD_BUFFER_CAPACITY = 64 * 1024;
+
+		struct ThreadBuffer;
+
+		// Guards the file handle and format registration
+		std::mutex s_FileMutex;
+		std::FILE* s_File         = nullptr;
+		uint32_t   s_NextFormatID = 1;
+		int64_t    s_SteadyOrigin = 0;
+
+		std::mutex                 s_ThreadBuffersMutex;
+		std::vector<ThreadBuffer*> s_ThreadBuffers;
+
+		std::atomic<uint32_t> s_NextThreadID = 1;
+
+		int64_t GetSteadyNanoseconds()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			           std::chrono::steady_clock::now().time_since_epoch()
+			)
+			    .count();
+		}
+
+		void WriteToFile(const void* data, size_t size)
+		{
+			if (s_File && size > 0)
+				std::fwrite(data, 1, size, s_File);
+		}
+
+		struct ThreadBuffer
+		{
+			// Only contended when another thread flushes this buffer
+			std::mutex Mutex;
+
+			std::vector<std::byte> Data;
+			size_t                 MessageStart = 0;
+			uint32_t               ThreadID     = s_NextThreadID.fetch_add(1, std::memory_order_relaxed);
+
+			ThreadBuffer()
+			{
+				Data.reserve(THREAD_BUFFER_CAPACITY);
+
+				std::lock_guard lock(s_ThreadBuffersMutex);
+				s_ThreadBuffers.push_back(this);
+			}
+
+			~ThreadBuffer()
+			{
+				{
+					std::lock_guard lock(s_ThreadBuffersMutex);
+					std::erase(s_ThreadBuffers, this);
+				}
+
+				std::lock_guard lock(Mutex);
+				FlushLocked();
+			}
+
+			// Caller holds Mutex
+			void FlushLocked()
+			{
+				{
+					std::lock_guard lock(s_FileMutex);
+					WriteToFile(Data.data(), Data.size());
+				}
+				Data.clear();
+			}
+		};
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			thread_local ThreadBuffer buffer;
+			return buffer;
+		}
+	}        // namespace
+
+	bool BinaryLog::Open(const std::filesystem::path& path)
+	{
+		Close();
+
+		std::lock_guard lock(s_FileMutex);
+
+		s_File = std::fopen(path.string().c_str(), "wb");
+		if (!s_File)
+			return false;
+
+		s_SteadyOrigin = GetSteadyNanoseconds();
+		s_NextFormatID = 1;
+
+		BinaryLogFormat::FileHeader header{};
+		header.WallClockNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		                         std::chrono::system_clock::now().time_since_epoch()
+		)
+		                         .count();
+		header.SteadyClockNs = s_SteadyOrigin;
+		WriteToFile(&header, sizeof(header));
+
+		// Invalidates the format IDs cached by call sites for a previous file
+		s_Generation.fetch_add(1, std::memory_order_release);
+		s_Open.store(true, std::memory_order_release);
+
+		return true;
+	}
+
+	void BinaryLog::Close()
+	{
+		if (!s_Open.exchange(false, std::memory_order_acq_rel))
+			return;
+
+		Flush();
+
+		std::lock_guard lock(s_FileMutex);
+		std::fclose(s_File);
+		s_File = nullptr;
+	}
+
+	void BinaryLog::Flush()
+	{
+		{
+			std::lock_guard lock(s_ThreadBuffersMutex);
+			for (ThreadBuffer* buffer : s_ThreadBuffers)
+			{
+				std::lock_guard bufferLock(buffer->Mutex);
+				buffer->FlushLocked();
+			}
+		}
+
+		std::lock_guard lock(s_FileMutex);
+		if (s_File)
+			std::fflush(s_File);
+	}
+
+	void BinaryLog::EncodeString(std::vector<std::byte>& buffer, std::string_view string)
+	{
+		const auto length = static_cast<uint16_t>(std::min<size_t>(string.size(), BinaryLogFormat::MaxStringLength));
+		EncodeValue<uint16_t>(buffer, length);
+
+		const size_t offset = buffer.size();
+		buffer.resize(offset + length);
+		std::memcpy(buffer.data() + offset, string.data(), length);
+	}
+
+	uint32_t BinaryLog::ResolveFormat(
+	    BinaryLogSite&                            site,
+	    uint8_t                                   level,
+	    std::string_view                          tag,
+	    std::string_view                          format,
+	    std::span<const BinaryLogFormat::ArgType> argTypes
+	)
+	{
+		std::lock_guard lock(s_FileMutex);
+
+		const uint32_t generation = s_Generation.load(std::memory_order_relaxed);
+
+		// Another thread may have registered the site while we were waiting for the lock
+		const uint64_t siteFormat = site.Format.load(std::memory_order_acquire);
+		if ((siteFormat >> 32) == generation)
+			return static_cast<uint32_t>(siteFormat);
+
+		const std::string_view file = site.File ? std::string_view(site.File) : std::string_view();
+
+		const BinaryLogFormat::FormatRecord record{
+		    .FormatID     = s_NextFormatID++,
+		    .Level        = level,
+		    .ArgCount     = static_cast<uint8_t>(argTypes.size()),
+		    .TagLength    = static_cast<uint16_t>(std::min<size_t>(tag.size(), BinaryLogFormat::MaxStringLength)),
+		    .FormatLength = static_cast<uint16_t>(std::min<size_t>(format.size(), BinaryLogFormat::MaxStringLength)),
+		    .FileLength   = static_cast<uint16_t>(std::min<size_t>(file.size(), BinaryLogFormat::MaxStringLength)),
+		    .Line         = site.Line
+		};
+
+		// Written straight to the file so it always precedes the messages that reference it
+		constexpr auto recordType = BinaryLogFormat::RecordType::Format;
+		WriteToFile(&recordType, sizeof(recordType));
+		WriteToFile(&record, sizeof(record));
+		WriteToFile(argTypes.data(), argTypes.size_bytes());
+		WriteToFile(tag.data(), record.TagLength);
+		WriteToFile(format.data(), record.FormatLength);
+		WriteToFile(file.data(), record.FileLength);
+
+		site.Format.store((static_cast<uint64_t>(generation) << 32) | record.FormatID, std::memory_order_release);
+
+		return record.FormatID;
+	}
+
+	std::vector<std::byte>& BinaryLog::BeginMessage(uint32_t formatID)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		buffer.Mutex.lock();
+
+		buffer.MessageStart = buffer.Data.size();
+
+		const BinaryLogFormat::MessageRecord record{
+		    .FormatID    = formatID,
+		    .ThreadID    = buffer.ThreadID,
+		    .TimestampNs = GetSteadyNanoseconds() - s_SteadyOrigin,
+		    .PayloadSize = 0
+		};
+
+		EncodeValue(buffer.Data, BinaryLogFormat::RecordType::Message);
+		EncodeValue(buffer.Data, record);
+
+		return buffer.Data;
+	}
+
+	void BinaryLog::EndMessage(bool commit)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		if (!commit)
+		{
+			buffer.Data.resize(buffer.MessageStart);
+			buffer.Mutex.unlock();
+			return;
+		}
+
+		constexpr size_t headerSize = sizeof(BinaryLogFormat::RecordType) + sizeof(BinaryLogFormat::MessageRecord);
+		const auto payloadSize = static_cast<uint32_t>(buffer.Data.size() - buffer.MessageStart - headerSize);
+
+		std::memcpy(
+		    buffer.Data.data() + buffer.MessageStart + sizeof(BinaryLogFormat::RecordType) +
+		        offsetof(BinaryLogFormat::MessageRecord, PayloadSize),
+		    &payloadSize,
+		    sizeof(payloadSize)
+		);
+
+		if (buffer.Data.size() >= THREAD_BUFFER_CAPACITY)
+			buffer.FlushLocked();
+
+		buffer.Mutex.unlock();
+	}
+}        // namespace Eruption
@@ -0,0 +1,185 @@
+#pragma once
+#include "Eruption/Core/BinaryLogFormat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Eruption
+{
+	// Per call site state of the binary log, owned by a static in the logging macros
+	struct BinaryLogSite
+	{
+		const char* File = nullptr;
+		uint32_t    Line = 0;
+
+		// File generation in the high half, format ID in the low half; 0 means not registered yet
+		std::atomic<uint64_t> Format = 0;
+	};
+
+	// Deferred-format logging: call sites record a format ID and the raw argument bytes into a
+	// per-thread buffer which is appended to the file in chunks. Text is only produced offline
+	// by the LogDecoder tool.
+	class BinaryLog
+	{
+	public:
+		static bool Open(const std::filesystem::path& path);
+		static void Close();
+
+		// Appends every thread's pending records to the file
+		static void Flush();
+
+		[[nodiscard]] static bool IsOpen() { return s_Open.load(std::memory_order_relaxed); }
+
+		template <typename... Args>
+		static void Write(
+		    BinaryLogSite& site, uint8_t level, std::string_view tag, std::string_view format, const Args&... args
+		);
+
+	private:
+		template <typename T>
+		static constexpr BinaryLogFormat::ArgType GetArgType();
+
+		template <typename T>
+		static void EncodeArg(std::vector<std::byte>& buffer, const T& arg);
+
+		static void EncodeString(std::vector<std::byte>& buffer, std::string_view string);
+
+		template <typename T>
+		static void EncodeValue(std::vector<std::byte>& buffer, T value)
+		{
+			const size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			std::memcpy(buffer.data() + offset, &value, sizeof(T));
+		}
+
+		static uint32_t ResolveFormat(
+		    BinaryLogSite&                            site,
+		    uint8_t                                   level,
+		    std::string_view                          tag,
+		    std::string_view                          format,
+		    std::span<const BinaryLogFormat::ArgType> argTypes
+		);
+
+		// Locks the calling thread's buffer and appends a message header. EndMessage patches the size of a
+		// committed message, drops one that is not, and unlocks.
+		static std::vector<std::byte>& BeginMessage(uint32_t formatID);
+		static void                    EndMessage(bool commit);
+
+		// Pairs BeginMessage with EndMessage, so a message whose arguments throw while encoding, e.g. bad_alloc
+		// from growing the buffer, is dropped and does not leave the buffer locked
+		class MessageWriter
+		{
+		public:
+			explicit MessageWriter(uint32_t formatID) : m_Data(BeginMessage(formatID)) {}
+			~MessageWriter() { EndMessage(m_Committed); }
+
+			MessageWriter(const MessageWriter&)            = delete;
+			MessageWriter& operator=(const MessageWriter&) = delete;
+
+			[[nodiscard]] std::vector<std::byte>& GetData() const { return m_Data; }
+
+			void Commit() { m_Committed = true; }
+
+		private:
+			std::vector<std::byte>& m_Data;
+			bool                    m_Committed = false;
+		};
+
+	private:
+		inline static std::atomic<bool>     s_Open       = false;
+		inline static std::atomic<uint32_t> s_Generation = 0;
+	};
+
+	template <typename T>
+	constexpr BinaryLogFormat::ArgType BinaryLog::GetArgType()
+	{
+		using namespace BinaryLogFormat;
+		using Type = std::remove_cvref_t<std::decay_t<T>>;
+
+		if constexpr (std::same_as<Type, bool>)
+			return ArgType::Bool;
+		else if constexpr (std::same_as<Type, char>)
+			return ArgType::Char;
+		else if constexpr (std::integral<Type> && std::is_signed_v<Type>)
+			return sizeof(Type) <= sizeof(int32_t) ? ArgType::Int32 : ArgType::Int64;
+		else if constexpr (std::integral<Type>)
+			return sizeof(Type) <= sizeof(uint32_t) ? ArgType::UInt32 : ArgType::UInt64;
+		else if constexpr (std::same_as<Type, float>)
+			return ArgType::Float;
+		else if constexpr (std::floating_point<Type>)
+			return ArgType::Double;
+		else if constexpr (std::same_as<Type, const char*> || std::same_as<Type, char*>)
+			return ArgType::String;
+		else if constexpr (std::is_pointer_v<Type> || std::same_as<Type, std::nullptr_t>)
+			return ArgType::Pointer;
+		else if constexpr (std::convertible_to<const Type&, std::string_view>)
+			return ArgType::String;
+		else
+			return ArgType::Formatted;
+	}
+
+	template <typename T>
+	void BinaryLog::EncodeArg(std::vector<std::byte>& buffer, const T& arg)
+	{
+		using namespace BinaryLogFormat;
+		using Type = std::remove_cvref_t<std::decay_t<T>>;
+
+		constexpr ArgType type = GetArgType<T>();
+
+		if constexpr (type == ArgType::Bool)
+			EncodeValue<uint8_t>(buffer, arg ? 1 : 0);
+		else if constexpr (type == ArgType::Char)
+			EncodeValue<char>(buffer, arg);
+		else if constexpr (type == ArgType::Int32)
+			EncodeValue<int32_t>(buffer, static_cast<int32_t>(arg));
+		else if constexpr (type == ArgType::Int64)
+			EncodeValue<int64_t>(buffer, static_cast<int64_t>(arg));
+		else if constexpr (type == ArgType::UInt32)
+			EncodeValue<uint32_t>(buffer, static_cast<uint32_t>(arg));
+		else if constexpr (type == ArgType::UInt64)
+			EncodeValue<uint64_t>(buffer, static_cast<uint64_t>(arg));
+		else if constexpr (type == ArgType::Float)
+			EncodeValue<float>(buffer, arg);
+		else if constexpr (type == ArgType::Double)
+			EncodeValue<double>(buffer, static_cast<double>(arg));
+		else if constexpr (type == ArgType::Pointer)
+			EncodeValue<uint64_t>(buffer, reinterpret_cast<uintptr_t>(static_cast<const void*>(arg)));
+		else if constexpr (std::same_as<Type, const char*> || std::same_as<Type, char*>)
+			EncodeString(buffer, arg ? std::string_view(arg) : std::string_view("(null)"));
+		else if constexpr (std::convertible_to<const T&, std::string_view>)
+			EncodeString(buffer, std::string_view(arg));
+		else
+			EncodeString(buffer, std::format("{}", arg));
+	}
+
+	template <typename... Args>
+	void BinaryLog::Write(
+	    BinaryLogSite& site, uint8_t level, std::string_view tag, std::string_view format, const Args&... args
+	)
+	{
+		static_assert(sizeof...(Args) <= BinaryLogFormat::MaxArgs, "Too many arguments for a binary log message");
+
+		static constexpr std::array<BinaryLogFormat::ArgType, sizeof...(Args)> ARG_TYPES = {GetArgType<Args>()...};
+
+		// Fast path: the site was already registered in the currently open file
+		const uint64_t siteFormat = site.Format.load(std::memory_order_acquire);
+		const uint32_t formatID   = (siteFormat >> 32) == s_Generation.load(std::memory_order_relaxed)
+		                                ? static_cast<uint32_t>(siteFormat)
+		                                : ResolveFormat(site, level, tag, format, ARG_TYPES);
+
+		MessageWriter writer(formatID);
+		(EncodeArg(writer.GetData(), args), ...);
+		writer.Commit();
+	}
+}        // namespace Eruption
@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// On-disk layout of binary log files. Shared by the engine writer and the offline decoder,
+// so this header must not depend on anything else in the engine.
+//
+// File := FileHeader Record*
+// Record := RecordType (uint8_t) followed by FormatRecord or MessageRecord
+//
+// A FormatRecord is written once per call site and file, before any message that refers to it:
+//     FormatRecord, ArgType[ArgCount], tag bytes, format bytes, file name bytes
+// A MessageRecord carries only the format ID, a timestamp and the raw argument bytes:
+//     MessageRecord, payload bytes
+// Payload encoding per ArgType: fixed-size little-endian values, strings as uint16_t length + bytes.
+namespace Eruption::BinaryLogFormat
+{
+	inline constexpr std::array<char, 8> Magic   = {'E', 'R', 'B', 'L', 'O', 'G', '\0', '\0'};
+	inline constexpr uint32_t            Version = 2;        // 2 added ArgType::Formatted
+
+	inline constexpr uint32_t MaxArgs         = 16;
+	inline constexpr uint32_t MaxStringLength = UINT16_MAX;
+
+	enum class RecordType : uint8_t
+	{
+		Format  = 1,
+		Message = 2
+	};
+
+	enum class ArgType : uint8_t
+	{
+		Bool = 0,
+		Char,
+		Int32,
+		UInt32,
+		Int64,
+		UInt64,
+		Float,
+		Double,
+		String,
+		Pointer,
+		Formatted        // Text formatted with {} at the call site, so the call site's spec does not apply to it
+	};
+
+#pragma pack(push, 1)
+	struct FileHeader
+	{
+		std::array<char, 8> FileMagic     = Magic;
+		uint32_t            FileVersion   = Version;
+		uint32_t            Reserved      = 0;
+		int64_t             WallClockNs   = 0;        // system_clock time matching SteadyClockNs
+		int64_t             SteadyClockNs = 0;        // Message timestamps are relative to this
+	};
+
+	struct FormatRecord
+	{
+		uint32_t FormatID;
+		uint8_t  Level;
+		uint8_t  ArgCount;
+		uint16_t TagLength;
+		uint16_t FormatLength;
+		uint16_t FileLength;
+		uint32_t Line;
+	};
+
+	struct MessageRecord
+	{
+		uint32_t FormatID;
+		uint32_t ThreadID;
+		int64_t  TimestampNs;
+		uint32_t PayloadSize;
+	};
+#pragma pack(pop)
+}        // namespace Eruption::BinaryLogFormat
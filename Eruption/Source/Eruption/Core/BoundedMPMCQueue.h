@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Eruption
+{
+	// Lock-free bounded multi-producer/multi-consumer queue (Vyukov's sequence-per-cell design).
+	// Elements are written and read in place through callbacks, so payloads that own memory
+	// (e.g. strings) keep their capacity between uses and steady-state traffic does not allocate.
+	template <typename T>
+	class BoundedMPMCQueue
+	{
+	public:
+		explicit BoundedMPMCQueue(size_t capacity) :
+		    m_Cells(std::make_unique<Cell[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))),
+		    m_Mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+		{
+			for (size_t i = 0; i <= m_Mask; ++i)
+				m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+
+		BoundedMPMCQueue(const BoundedMPMCQueue&)            = delete;
+		BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+		// Calls write(T&) on a free cell and publishes it. Returns false if the queue is full.
+		template <typename TWriter>
+		bool TryPush(TWriter&& write)
+		{
+			size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			Cell*  cell;
+
+			while (true)
+			{
+				cell = &m_Cells[position & m_Mask];
+
+				const size_t   sequence   = cell->Sequence.load(std::memory_order_acquire);
+				const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+				if (difference == 0)
+				{
+					if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			write(cell->Data);
+			cell->Sequence.store(position + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		// Calls read(T&) on the oldest element and releases its cell. Returns false if the queue is empty.
+		template <typename TReader>
+		bool TryPop(TReader&& read)
+		{
+			size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+			Cell*  cell;
+
+			while (true)
+			{
+				cell = &m_Cells[position & m_Mask];
+
+				const size_t   sequence   = cell->Sequence.load(std::memory_order_acquire);
+				const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+				if (difference == 0)
+				{
+					if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_DequeuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			read(cell->Data);
+			cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		[[nodiscard]] size_t GetCapacity() const { return m_Mask + 1; }
+
+	private:
+		static constexpr size_t CacheLineSize = 64;
+
+		struct Cell
+		{
+			std::atomic<size_t> Sequence;
+			T                   Data;
+		};
+
+	private:
+		std::unique_ptr<Cell[]> m_Cells;
+		const size_t            m_Mask;
+
+		alignas(CacheLineSize) std::atomic<size_t> m_EnqueuePosition = 0;
+		alignas(CacheLineSize) std::atomic<size_t> m_DequeuePosition = 0;
+	};
+}        // namespace Eruption
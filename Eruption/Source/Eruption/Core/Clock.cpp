@@ -0,0 +1,78 @@
+#include "Clock.h"
+
+#ifdef ER_CLOCK_HAS_TSC
+#	ifndef ER_PLATFORM_WINDOWS
+#		include <cpuid.h>
+#	endif
+#endif
+
+namespace Eruption
+{
+	namespace
+	{
+		// Long enough for steady_clock's read jitter to stay well below 0.01%
+		constexpr int64_t CALIBRATION_DURATION_NS = 5'000'000;
+
+		int64_t GetSteadyNanoseconds()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			           std::chrono::steady_clock::now().time_since_epoch()
+			)
+			    .count();
+		}
+
+#ifdef ER_CLOCK_HAS_TSC
+		// Only an invariant TSC ticks at a constant rate across frequency changes and sleep states
+		bool HasInvariantTsc()
+		{
+			uint32_t registers[4] = {};
+#	ifdef ER_PLATFORM_WINDOWS
+			__cpuid(reinterpret_cast<int*>(registers), 0x80000000);
+			if (registers[0] < 0x80000007)
+				return false;
+			__cpuid(reinterpret_cast<int*>(registers), 0x80000007);
+#	else
+			if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+				return false;
+			__get_cpuid(0x80000007, &registers[0], &registers[1], &registers[2], &registers[3]);
+#	endif
+			return (registers[3] & (1u << 8)) != 0;
+		}
+#endif
+
+		[[maybe_unused]] const bool s_Calibrated = (Clock::Calibrate(), true);
+	}        // namespace
+
+	void Clock::Calibrate()
+	{
+		s_UseTsc             = false;
+		s_NanosecondsPerTick = 1.0;
+		s_EpochTicks         = GetSteadyNanoseconds();
+		s_EpochNanoseconds   = s_EpochTicks;
+
+#ifdef ER_CLOCK_HAS_TSC
+		if (!HasInvariantTsc())
+			return;
+
+		// Spin instead of sleeping so the measurement window is not stretched by the scheduler
+		const int64_t  beginNs    = GetSteadyNanoseconds();
+		const uint64_t beginTicks = __rdtsc();
+
+		int64_t  endNs    = beginNs;
+		uint64_t endTicks = beginTicks;
+		while (endNs - beginNs < CALIBRATION_DURATION_NS)
+		{
+			endTicks = __rdtsc();
+			endNs    = GetSteadyNanoseconds();
+		}
+
+		if (endTicks <= beginTicks)
+			return;
+
+		s_UseTsc             = true;
+		s_NanosecondsPerTick = static_cast<double>(endNs - beginNs) / static_cast<double>(endTicks - beginTicks);
+		s_EpochTicks         = static_cast<int64_t>(endTicks);
+		s_EpochNanoseconds   = endNs;
+#endif
+	}
+}        // namespace Eruption
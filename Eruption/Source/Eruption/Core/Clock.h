@@ -0,0 +1,75 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	ifdef ER_PLATFORM_WINDOWS
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif
+#	define ER_CLOCK_HAS_TSC
+#endif
+
+namespace Eruption
+{
+	// Monotonic tick source for anything that times code. Ticks come from the invariant TSC when the CPU has
+	// one and from steady_clock nanoseconds otherwise, so a reading is a few nanoseconds at most. Ticks only
+	// mean something relative to each other: hot paths store them as is and convert when reporting.
+	class Clock
+	{
+	public:
+		[[nodiscard]] static int64_t GetTicks()
+		{
+#ifdef ER_CLOCK_HAS_TSC
+			if (s_UseTsc)
+				return static_cast<int64_t>(__rdtsc());
+#endif
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			           std::chrono::steady_clock::now().time_since_epoch()
+			)
+			    .count();
+		}
+
+		// Tick intervals
+		[[nodiscard]] static int64_t ToNanoseconds(int64_t ticks)
+		{
+			return static_cast<int64_t>(static_cast<double>(ticks) * s_NanosecondsPerTick);
+		}
+		[[nodiscard]] static double ToMilliseconds(int64_t ticks)
+		{
+			return static_cast<double>(ticks) * s_NanosecondsPerTick * 1e-6;
+		}
+		[[nodiscard]] static double ToSeconds(int64_t ticks)
+		{
+			return static_cast<double>(ticks) * s_NanosecondsPerTick * 1e-9;
+		}
+		[[nodiscard]] static int64_t FromNanoseconds(int64_t nanoseconds)
+		{
+			return static_cast<int64_t>(static_cast<double>(nanoseconds) / s_NanosecondsPerTick);
+		}
+
+		// Tick readings on the steady_clock nanosecond timeline, for comparing against other clocks
+		[[nodiscard]] static int64_t ToSteadyNanoseconds(int64_t ticks)
+		{
+			return s_EpochNanoseconds + ToNanoseconds(ticks - s_EpochTicks);
+		}
+		[[nodiscard]] static int64_t FromSteadyNanoseconds(int64_t nanoseconds)
+		{
+			return s_EpochTicks + FromNanoseconds(nanoseconds - s_EpochNanoseconds);
+		}
+
+		[[nodiscard]] static bool   IsUsingTsc() { return s_UseTsc; }
+		[[nodiscard]] static double GetTicksPerSecond() { return 1e9 / s_NanosecondsPerTick; }
+
+		// Measures the TSC rate against steady_clock. Runs once during static initialization of the core
+		// library, before any other thread exists; ticks read before it are not comparable with later ones.
+		static void Calibrate();
+
+	private:
+		inline static bool    s_UseTsc             = false;
+		inline static double  s_NanosecondsPerTick = 1.0;
+		inline static int64_t s_EpochTicks         = 0;
+		inline static int64_t s_EpochNanoseconds   = 0;
+	};
+}        // namespace Eruption
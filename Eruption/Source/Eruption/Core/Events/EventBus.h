@@ -3,6 +3,8 @@
 #include "Eruption/Core/Base.h"
 #include "Eruption/Core/Events/Event.h"
 
+#include "Eruption/Debug/Metrics.h"
+
 #include <algorithm>
 #include <functional>
 #include <memory>
@@ -32,15 +34,14 @@ namespace Eruption
 	class TEventHandler : public IEventHandler
 	{
 	public:
-		TEventHandler(TEventCallback&& callback, uint32_t priority) :
-		    m_Callback(std::forward<TEventCallback>(callback)), m_Priority(priority)
+		TEventHandler(TEventCallback callback, uint32_t priority) : m_Callback(std::move(callback)), m_Priority(priority)
 		{}
 
 		bool Invoke(Event& event) override
 		{
 			if (event.GetEventType() == TEvent::GetStaticType() && !event.Handled)
 			{
-				event.Handled |= Callback(static_cast<TEvent&>(event));
+				event.Handled |= m_Callback(static_cast<TEvent&>(event));
 			}
 
 			return event.Handled;
@@ -64,22 +65,21 @@ namespace Eruption
 		{
 			auto& handlers = m_Handlers[TEvent::GetStaticType()];
 
-			auto handler = CreateScope<TEventHandler>(std::forward<TEventCallback>(callback), priority);
-
-			// Insert sorted by priority (descending order)
-			auto insertIt = std::ranges::lower_bound(
-			    handlers,
-			    priority,
-			    [](const auto& handler, uint32_t prio) { return handler->GetPriority() > prio; },
-			    &IEventHandler::GetPriority
+			Scope<IEventHandler> handler = CreateScope<TEventHandler<TEvent, std::decay_t<TEventCallback>>>(
+			    std::forward<TEventCallback>(callback), priority
 			);
 
+			// Insert sorted by priority (descending order), after handlers of the same priority
+			auto insertIt = std::ranges::upper_bound(handlers, priority, std::greater{}, &IEventHandler::GetPriority);
+
 			handlers.insert(insertIt, std::move(handler));
 		}
 
 		template <CEvent TEvent>
 		bool Publish(TEvent& event)
 		{
+			GetDispatchCounter().Increment();
+
 			auto it = m_Handlers.find(event.GetEventType());
 			if (it == m_Handlers.end())
 				return false;
@@ -126,6 +126,8 @@ namespace Eruption
 	private:
 		void PublishDynamic(Event& event)
 		{
+			GetDispatchCounter().Increment();
+
 			const auto it = m_Handlers.find(event.GetEventType());
 			if (it == m_Handlers.end())
 				return;
@@ -137,6 +139,13 @@ namespace Eruption
 			}
 		}
 
+		static MetricCounter& GetDispatchCounter()
+		{
+			static MetricCounter& s_Counter =
+			    Metrics::GetPerFrameCounter("eruption_events_dispatched_total", "Events published on event buses");
+			return s_Counter;
+		}
+
 	private:
 		std::unordered_map<EventType, std::vector<Scope<IEventHandler>>> m_Handlers;
 		std::vector<Scope<Event>>                                        m_EventQueue;
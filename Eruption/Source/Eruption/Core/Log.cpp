@@ -1,11 +1,25 @@
 #include "Log.h"
 
+#include "Eruption/Core/AsyncLogBackend.h"
+#include "Eruption/Core/Base.h"
+
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <mutex>
+#include <optional>
+
 namespace Eruption
 {
-	void Log::Init()
+	namespace
+	{
+		// Only taken when a new tag is registered; lookups of existing tags are lock-free
+		std::mutex s_TagRegistryMutex;
+
+		Scope<AsyncLogBackend> s_AsyncBackend;
+	}        // namespace
+
+	void Log::Init(const LogSpecification& specification)
 	{
 		auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
 
@@ -14,11 +28,126 @@ namespace Eruption
 
 		s_CoreLogger = std::make_shared<spdlog::logger>("ERUPTION", consoleSink);
 		s_CoreLogger->set_level(spdlog::level::trace);
+
+		if (specification.Async)
+			s_AsyncBackend = CreateScope<AsyncLogBackend>(s_CoreLogger, specification);
+
+		if (!specification.BinaryLogFile.empty() && !BinaryLog::Open(specification.BinaryLogFile))
+			s_CoreLogger->error("Failed to open binary log file '{0}'", specification.BinaryLogFile);
 	}
 
 	void Log::Shutdown()
 	{
+		BinaryLog::Close();
+
+		// Drains the queue before the sinks go away
+		s_AsyncBackend.reset();
+
 		s_CoreLogger.reset();
 		spdlog::drop_all();
 	}
-}        // namespace Eruption
\ No newline at end of file
+
+	Log::TagID Log::InternTag(std::string_view tag)
+	{
+		if (tag.empty())
+			return UntaggedID;
+
+		const auto findTag = [tag]() -> std::optional<TagID> {
+			const uint32_t count = s_TagCount.load(std::memory_order_acquire);
+			for (uint32_t i = 1; i < count; ++i)
+			{
+				if (s_TagNames[i] == tag)
+					return static_cast<TagID>(i);
+			}
+			return std::nullopt;
+		};
+
+		if (const std::optional<TagID> id = findTag())
+			return *id;
+
+		std::lock_guard lock(s_TagRegistryMutex);
+
+		// Another thread may have registered the tag while we were waiting for the lock
+		if (const std::optional<TagID> id = findTag())
+			return *id;
+
+		const uint32_t count = s_TagCount.load(std::memory_order_relaxed);
+		if (count >= MaxTags)
+		{
+			if (s_CoreLogger)
+				s_CoreLogger->error("Log tag limit ({0}) reached, '{1}' is logged as untagged", MaxTags, tag);
+			return UntaggedID;
+		}
+
+		s_TagNames[count] = tag;
+		s_TagCount.store(count + 1, std::memory_order_release);
+
+		return static_cast<TagID>(count);
+	}
+
+	bool Log::HasTag(std::string_view tag)
+	{
+		const uint32_t count = s_TagCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (s_TagNames[i] == tag)
+				return true;
+		}
+		return false;
+	}
+
+	void Log::SetTagDetails(std::string_view tag, TagDetails details)
+	{
+		const uint8_t filter = static_cast<uint8_t>(details.LevelFilter) | (details.Enabled ? 0u : TagDisabledBit);
+		s_TagFilters[InternTag(tag)].store(filter, std::memory_order_relaxed);
+	}
+
+	Log::TagDetails Log::GetTagDetails(std::string_view tag)
+	{
+		const uint8_t filter = s_TagFilters[InternTag(tag)].load(std::memory_order_relaxed);
+		return {
+		    .Enabled     = (filter & TagDisabledBit) == 0,
+		    .LevelFilter = static_cast<Level>(filter & ~TagDisabledBit)
+		};
+	}
+
+	void Log::Flush()
+	{
+		BinaryLog::Flush();
+
+		if (s_AsyncBackend)
+			s_AsyncBackend->Flush();
+		else if (s_CoreLogger)
+			s_CoreLogger->flush();
+	}
+
+	void Log::Write(Type type, Level level, std::string_view message)
+	{
+		if (s_AsyncBackend)
+		{
+			s_AsyncBackend->Push(level, message);
+			return;
+		}
+
+		s_CoreLogger->log(ToSpdlogLevel(level), message);
+
+		if (level == Level::Fatal)
+			s_CoreLogger->flush();
+	}
+
+	std::string& Log::GetFormatBuffer(TagID tag)
+	{
+		// Reused across calls so steady-state logging does not allocate
+		thread_local std::string buffer;
+
+		buffer.clear();
+		if (tag != UntaggedID)
+		{
+			buffer.push_back('[');
+			buffer.append(s_TagNames[tag]);
+			buffer.append("] ");
+		}
+
+		return buffer;
+	}
+}        // namespace Eruption
@@ -1,13 +1,38 @@
 #pragma once
+#include "Eruption/Core/BinaryLog.h"
+#include "Eruption/Core/LogLimiter.h"
+
 #include <spdlog/spdlog.h>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <format>
-#include <map>
+#include <iterator>
 #include <memory>
+#include <string>
+#include <string_view>
 
 namespace Eruption
 {
+	enum class LogOverflowPolicy : uint8_t
+	{
+		Block,             // Wait for the background thread to make room
+		DropOldest,        // Discard the oldest queued message
+		DropNewest         // Discard the message being logged
+	};
+
+	struct LogSpecification
+	{
+		bool              Async          = true;
+		uint32_t          QueueCapacity  = 8192;        // Rounded up to a power of two
+		LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::DropOldest;
+
+		// When set, macro call sites write deferred-format records to this file instead of text.
+		// Errors and fatal messages are still printed to the console as well.
+		std::string BinaryLogFile;
+	};
+
 	class Log
 	{
 	public:
@@ -31,24 +56,55 @@ namespace Eruption
 			Level LevelFilter = Level::Trace;
 		};
 
+		// Small integer handle of an interned tag, used to index the filter table
+		using TagID = uint16_t;
+
+		static constexpr TagID    UntaggedID = 0;
+		static constexpr uint32_t MaxTags    = 256;
+
 	public:
-		static void Init();
+		static void Init(const LogSpecification& specification = {});
 		static void Shutdown();
 
+		// Blocks until every message logged so far has reached the sinks
+		static void Flush();
+
 		static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
 
-		static bool HasTag(const std::string& tag) { return s_EnabledTags.contains(tag); }
+		// Tags are interned once per call site by the logging macros, so the hot path is a single relaxed load
+		[[nodiscard]] static TagID InternTag(std::string_view tag);
+		[[nodiscard]] static bool  HasTag(std::string_view tag);
+
+		[[nodiscard]] static std::string_view GetTagName(TagID tag) { return s_TagNames[tag]; }
+
+		static void                     SetTagDetails(std::string_view tag, TagDetails details);
+		[[nodiscard]] static TagDetails GetTagDetails(std::string_view tag);
 
-		static std::map<std::string, TagDetails>& EnabledTags() { return s_EnabledTags; }
+		[[nodiscard]] static bool IsEnabled(TagID tag, Level level)
+		{
+			return static_cast<uint8_t>(level) >= s_TagFilters[tag].load(std::memory_order_relaxed);
+		}
 
 		template <typename... Args>
 		static void PrintMessage(Type type, Level level, std::format_string<Args...> format, Args&&... args);
 
+		template <typename... Args>
+		static void PrintMessageTag(
+		    Type type, Level level, TagID tag, std::format_string<Args...> format, Args&&... args
+		);
+
 		template <typename... Args>
 		static void PrintMessageTag(
 		    Type type, Level level, std::string_view tag, std::format_string<Args...> format, Args&&... args
 		);
 
+		// Used by the logging macros after the filter check; routes to the binary log when one is open
+		template <typename... Args>
+		static void PrintMessageSite(
+		    BinaryLogSite& site, Type type, Level level, TagID tag, std::format_string<Args...> format, Args&&... args
+		);
+
+		static void PrintMessageTag(Type type, Level level, TagID tag, std::string_view message);
 		static void PrintMessageTag(Type type, Level level, std::string_view tag, std::string_view message);
 
 		template <typename... Args>
@@ -87,95 +143,262 @@ namespace Eruption
 
 			return Level::Trace;
 		}
+		static spdlog::level::level_enum ToSpdlogLevel(Level level)
+		{
+			switch (level)
+			{
+				case Level::Trace: return spdlog::level::trace;
+				case Level::Info:  return spdlog::level::info;
+				case Level::Warn:  return spdlog::level::warn;
+				case Level::Error: return spdlog::level::err;
+				case Level::Fatal: return spdlog::level::critical;
+			}
+			return spdlog::level::trace;
+		}
+
+	private:
+		// Hands an already formatted message to the sinks (or the async queue) without formatting it again
+		static void Write(Type type, Level level, std::string_view message);
+
+		static std::string& GetFormatBuffer(TagID tag);
 
 	private:
+		// Filter byte per tag: minimum enabled level, or the disabled bit set
+		static constexpr uint8_t TagDisabledBit = 0x80;
+
 		inline static std::shared_ptr<spdlog::logger> s_CoreLogger;
 
-		inline static std::map<std::string, TagDetails> s_EnabledTags;
+		inline static std::array<std::atomic<uint8_t>, MaxTags> s_TagFilters;
+		inline static std::array<std::string, MaxTags>          s_TagNames;
+		inline static std::atomic<uint32_t>                     s_TagCount = 1;
 	};
 
 }        // namespace Eruption
 
+// Compile-time minimum level, matching Log::Level. Call sites below it compile to nothing,
+// so their arguments are never evaluated. Can be overridden per target with a compile definition.
+#define ER_LOG_LEVEL_TRACE 0
+#define ER_LOG_LEVEL_INFO 1
+#define ER_LOG_LEVEL_WARN 2
+#define ER_LOG_LEVEL_ERROR 3
+#define ER_LOG_LEVEL_FATAL 4
+
+#ifndef ER_LOG_MIN_LEVEL
+#	if defined(ER_DIST)
+#		define ER_LOG_MIN_LEVEL ER_LOG_LEVEL_WARN
+#	elif defined(ER_RELEASE)
+#		define ER_LOG_MIN_LEVEL ER_LOG_LEVEL_INFO
+#	else
+#		define ER_LOG_MIN_LEVEL ER_LOG_LEVEL_TRACE
+#	endif
+#endif
+
+// The tag must be a compile-time string; its ID is resolved once per call site.
+// Arguments are only evaluated once the runtime filter has passed.
+#define ER_CORE_LOG_TAG_INTERNAL(level, tag, ...)                                                    \
+	do                                                                                               \
+	{                                                                                                \
+		constexpr std::string_view          erLogTagName = tag;                                      \
+		static const ::Eruption::Log::TagID erLogTagID   = ::Eruption::Log::InternTag(erLogTagName); \
+		if (::Eruption::Log::IsEnabled(erLogTagID, level))                                           \
+		{                                                                                            \
+			static ::Eruption::BinaryLogSite erLogSite{__FILE__, __LINE__};                          \
+			::Eruption::Log::PrintMessageSite(                                                       \
+			    erLogSite, ::Eruption::Log::Type::Core, level, erLogTagID, __VA_ARGS__               \
+			);                                                                                       \
+		}                                                                                            \
+	} while (0)
+
+// Shared by the ONCE / EVERY_N / RATE_LIMITED variants. The limiter is only consulted once the filter
+// has passed, and rate limited call sites write a summary line when earlier messages were suppressed.
+#define ER_CORE_LOG_LIMITED_INTERNAL(level, tag, shouldLog, ...)                                     \
+	do                                                                                               \
+	{                                                                                                \
+		constexpr std::string_view          erLogTagName = tag;                                      \
+		static const ::Eruption::Log::TagID erLogTagID   = ::Eruption::Log::InternTag(erLogTagName); \
+		if (::Eruption::Log::IsEnabled(erLogTagID, level))                                           \
+		{                                                                                            \
+			static ::Eruption::LogLimiter erLogLimiter;                                              \
+			uint64_t                      erLogSuppressed = 0;                                       \
+			if (erLogLimiter.shouldLog)                                                              \
+			{                                                                                        \
+				static ::Eruption::BinaryLogSite erLogSite{__FILE__, __LINE__};                      \
+				::Eruption::Log::PrintMessageSite(                                                   \
+				    erLogSite, ::Eruption::Log::Type::Core, level, erLogTagID, __VA_ARGS__           \
+				);                                                                                   \
+				if (erLogSuppressed > 0)                                                             \
+				{                                                                                    \
+					static ::Eruption::BinaryLogSite erLogSuppressedSite{__FILE__, __LINE__};        \
+					::Eruption::Log::PrintMessageSite(                                               \
+					    erLogSuppressedSite, ::Eruption::Log::Type::Core, level, erLogTagID,         \
+					    "Suppressed {0} repeats of the previous message", erLogSuppressed            \
+					);                                                                               \
+				}                                                                                    \
+			}                                                                                        \
+		}                                                                                            \
+	} while (0)
+
+#define ER_CORE_LOG_ONCE_INTERNAL(level, tag, ...) \
+	ER_CORE_LOG_LIMITED_INTERNAL(level, tag, ShouldLogOnce(), __VA_ARGS__)
+#define ER_CORE_LOG_EVERY_N_INTERNAL(level, tag, n, ...) \
+	ER_CORE_LOG_LIMITED_INTERNAL(level, tag, ShouldLogEveryN(n), __VA_ARGS__)
+#define ER_CORE_LOG_RATE_LIMITED_INTERNAL(level, tag, intervalMs, ...) \
+	ER_CORE_LOG_LIMITED_INTERNAL(level, tag, ShouldLogRateLimited(intervalMs, erLogSuppressed), __VA_ARGS__)
+
+// Expands macro(level, ...) when the level survives ER_LOG_MIN_LEVEL, and to nothing otherwise
+#if ER_LOG_MIN_LEVEL <= ER_LOG_LEVEL_TRACE
+#	define ER_CORE_LOG_TRACE_INTERNAL(macro, ...) macro(::Eruption::Log::Level::Trace, __VA_ARGS__)
+#else
+#	define ER_CORE_LOG_TRACE_INTERNAL(macro, ...) ((void) 0)
+#endif
+
+#if ER_LOG_MIN_LEVEL <= ER_LOG_LEVEL_INFO
+#	define ER_CORE_LOG_INFO_INTERNAL(macro, ...) macro(::Eruption::Log::Level::Info, __VA_ARGS__)
+#else
+#	define ER_CORE_LOG_INFO_INTERNAL(macro, ...) ((void) 0)
+#endif
+
+#if ER_LOG_MIN_LEVEL <= ER_LOG_LEVEL_WARN
+#	define ER_CORE_LOG_WARN_INTERNAL(macro, ...) macro(::Eruption::Log::Level::Warn, __VA_ARGS__)
+#else
+#	define ER_CORE_LOG_WARN_INTERNAL(macro, ...) ((void) 0)
+#endif
+
+#if ER_LOG_MIN_LEVEL <= ER_LOG_LEVEL_ERROR
+#	define ER_CORE_LOG_ERROR_INTERNAL(macro, ...) macro(::Eruption::Log::Level::Error, __VA_ARGS__)
+#else
+#	define ER_CORE_LOG_ERROR_INTERNAL(macro, ...) ((void) 0)
+#endif
+
+// Fatal messages are never stripped
+#define ER_CORE_LOG_FATAL_INTERNAL(macro, ...) macro(::Eruption::Log::Level::Fatal, __VA_ARGS__)
+
 // Core logging
-#define ER_CORE_TRACE_TAG(tag, ...) \
-	::Eruption::Log::PrintMessageTag(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Trace, tag, __VA_ARGS__)
-#define ER_CORE_INFO_TAG(tag, ...) \
-	::Eruption::Log::PrintMessageTag(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Info, tag, __VA_ARGS__)
-#define ER_CORE_WARN_TAG(tag, ...) \
-	::Eruption::Log::PrintMessageTag(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Warn, tag, __VA_ARGS__)
-#define ER_CORE_ERROR_TAG(tag, ...) \
-	::Eruption::Log::PrintMessageTag(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Error, tag, __VA_ARGS__)
-#define ER_CORE_FATAL_TAG(tag, ...) \
-	::Eruption::Log::PrintMessageTag(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Fatal, tag, __VA_ARGS__)
+#define ER_CORE_TRACE_TAG(tag, ...) ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_INFO_TAG(tag, ...) ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_WARN_TAG(tag, ...) ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_ERROR_TAG(tag, ...) ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_FATAL_TAG(tag, ...) ER_CORE_LOG_FATAL_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, tag, __VA_ARGS__)
 
 // Core Logging
-#define ER_CORE_TRACE(...) \
-	::Eruption::Log::PrintMessage(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Trace, __VA_ARGS__)
-#define ER_CORE_INFO(...) \
-	::Eruption::Log::PrintMessage(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Info, __VA_ARGS__)
-#define ER_CORE_WARN(...) \
-	::Eruption::Log::PrintMessage(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Warn, __VA_ARGS__)
-#define ER_CORE_ERROR(...) \
-	::Eruption::Log::PrintMessage(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Error, __VA_ARGS__)
-#define ER_CORE_FATAL(...) \
-	::Eruption::Log::PrintMessage(::Eruption::Log::Type::Core, ::Eruption::Log::Level::Fatal, __VA_ARGS__)
+#define ER_CORE_TRACE(...) ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_INFO(...) ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_WARN(...) ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_ERROR(...) ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_FATAL(...) ER_CORE_LOG_FATAL_INTERNAL(ER_CORE_LOG_TAG_INTERNAL, "", __VA_ARGS__)
+
+// Core logging, first call per call site only
+#define ER_CORE_TRACE_TAG_ONCE(tag, ...) ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_INFO_TAG_ONCE(tag, ...) ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_WARN_TAG_ONCE(tag, ...) ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, tag, __VA_ARGS__)
+#define ER_CORE_ERROR_TAG_ONCE(tag, ...) ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, tag, __VA_ARGS__)
+
+#define ER_CORE_TRACE_ONCE(...) ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_INFO_ONCE(...) ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_WARN_ONCE(...) ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, "", __VA_ARGS__)
+#define ER_CORE_ERROR_ONCE(...) ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_ONCE_INTERNAL, "", __VA_ARGS__)
+
+// Core logging, every n-th call per call site
+#define ER_CORE_TRACE_TAG_EVERY_N(tag, n, ...) \
+	ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, tag, n, __VA_ARGS__)
+#define ER_CORE_INFO_TAG_EVERY_N(tag, n, ...) \
+	ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, tag, n, __VA_ARGS__)
+#define ER_CORE_WARN_TAG_EVERY_N(tag, n, ...) \
+	ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, tag, n, __VA_ARGS__)
+#define ER_CORE_ERROR_TAG_EVERY_N(tag, n, ...) \
+	ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, tag, n, __VA_ARGS__)
+
+#define ER_CORE_TRACE_EVERY_N(n, ...) ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, "", n, __VA_ARGS__)
+#define ER_CORE_INFO_EVERY_N(n, ...) ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, "", n, __VA_ARGS__)
+#define ER_CORE_WARN_EVERY_N(n, ...) ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, "", n, __VA_ARGS__)
+#define ER_CORE_ERROR_EVERY_N(n, ...) ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_EVERY_N_INTERNAL, "", n, __VA_ARGS__)
+
+// Core logging, at most once per interval (in milliseconds) per call site
+#define ER_CORE_TRACE_TAG_RATE_LIMITED(tag, intervalMs, ...) \
+	ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, tag, intervalMs, __VA_ARGS__)
+#define ER_CORE_INFO_TAG_RATE_LIMITED(tag, intervalMs, ...) \
+	ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, tag, intervalMs, __VA_ARGS__)
+#define ER_CORE_WARN_TAG_RATE_LIMITED(tag, intervalMs, ...) \
+	ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, tag, intervalMs, __VA_ARGS__)
+#define ER_CORE_ERROR_TAG_RATE_LIMITED(tag, intervalMs, ...) \
+	ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, tag, intervalMs, __VA_ARGS__)
+
+#define ER_CORE_TRACE_RATE_LIMITED(intervalMs, ...) \
+	ER_CORE_LOG_TRACE_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, "", intervalMs, __VA_ARGS__)
+#define ER_CORE_INFO_RATE_LIMITED(intervalMs, ...) \
+	ER_CORE_LOG_INFO_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, "", intervalMs, __VA_ARGS__)
+#define ER_CORE_WARN_RATE_LIMITED(intervalMs, ...) \
+	ER_CORE_LOG_WARN_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, "", intervalMs, __VA_ARGS__)
+#define ER_CORE_ERROR_RATE_LIMITED(intervalMs, ...) \
+	ER_CORE_LOG_ERROR_INTERNAL(ER_CORE_LOG_RATE_LIMITED_INTERNAL, "", intervalMs, __VA_ARGS__)
 
 namespace Eruption
 {
 	template <typename... Args>
 	void Log::PrintMessage(Log::Type type, Log::Level level, std::format_string<Args...> format, Args&&... args)
 	{
-		const auto detail = s_EnabledTags[""];
-		if (detail.Enabled && detail.LevelFilter <= level)
-		{
-			auto logger = GetCoreLogger();
-			switch (level)
-			{
-				case Level::Trace: logger->trace(format, std::forward<Args>(args)...); break;
-				case Level::Info:  logger->info(format, std::forward<Args>(args)...); break;
-				case Level::Warn:  logger->warn(format, std::forward<Args>(args)...); break;
-				case Level::Error: logger->error(format, std::forward<Args>(args)...); break;
-				case Level::Fatal: logger->critical(format, std::forward<Args>(args)...); break;
-			}
-		}
+		PrintMessageTag(type, level, UntaggedID, format, std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	void Log::PrintMessageTag(
+	    Log::Type type, Log::Level level, Log::TagID tag, std::format_string<Args...> format, Args&&... args
+	)
+	{
+		if (!IsEnabled(tag, level))
+			return;
+
+		std::string& buffer = GetFormatBuffer(tag);
+		std::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+		Write(type, level, buffer);
 	}
 
 	template <typename... Args>
 	void Log::PrintMessageTag(
-	    Log::Type type, Log::Level level, std::string_view tag, const std::format_string<Args...> format, Args&&... args
+	    Log::Type type, Log::Level level, std::string_view tag, std::format_string<Args...> format, Args&&... args
+	)
+	{
+		PrintMessageTag(type, level, InternTag(tag), format, std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	void Log::PrintMessageSite(
+	    BinaryLogSite&              site,
+	    Log::Type                   type,
+	    Log::Level                  level,
+	    Log::TagID                  tag,
+	    std::format_string<Args...> format,
+	    Args&&... args
 	)
 	{
-		auto detail = s_EnabledTags[std::string(tag)];
-		if (detail.Enabled && detail.LevelFilter <= level)
+		// The macros have already checked IsEnabled before evaluating the arguments
+		if (BinaryLog::IsOpen())
 		{
-			const auto  logger    = GetCoreLogger();
-			std::string formatted = std::format(format, std::forward<Args>(args)...);
-			switch (level)
-			{
-				case Level::Trace: logger->trace("[{0}] {1}", tag, formatted); break;
-				case Level::Info:  logger->info("[{0}] {1}", tag, formatted); break;
-				case Level::Warn:  logger->warn("[{0}] {1}", tag, formatted); break;
-				case Level::Error: logger->error("[{0}] {1}", tag, formatted); break;
-				case Level::Fatal: logger->critical("[{0}] {1}", tag, formatted); break;
-			}
+			BinaryLog::Write(site, static_cast<uint8_t>(level), GetTagName(tag), format.get(), args...);
+
+			if (level < Level::Error)
+				return;
+
+			if (level == Level::Fatal)
+				BinaryLog::Flush();
 		}
+
+		PrintMessageTag(type, level, tag, format, std::forward<Args>(args)...);
+	}
+
+	inline void Log::PrintMessageTag(Log::Type type, Log::Level level, Log::TagID tag, std::string_view message)
+	{
+		if (!IsEnabled(tag, level))
+			return;
+
+		std::string& buffer = GetFormatBuffer(tag);
+		buffer.append(message);
+		Write(type, level, buffer);
 	}
 
 	inline void Log::PrintMessageTag(Log::Type type, Log::Level level, std::string_view tag, std::string_view message)
 	{
-		auto detail = s_EnabledTags[std::string(tag)];
-		if (detail.Enabled && detail.LevelFilter <= level)
-		{
-			const auto logger = GetCoreLogger();
-			switch (level)
-			{
-				case Level::Trace: logger->trace("[{0}] {1}", tag, message); break;
-				case Level::Info:  logger->info("[{0}] {1}", tag, message); break;
-				case Level::Warn:  logger->warn("[{0}] {1}", tag, message); break;
-				case Level::Error: logger->error("[{0}] {1}", tag, message); break;
-				case Level::Fatal: logger->critical("[{0}] {1}", tag, message); break;
-			}
-		}
+		PrintMessageTag(type, level, InternTag(tag), message);
 	}
 
 	template <typename... Args>
@@ -183,14 +406,18 @@ namespace Eruption
 	    Log::Type type, std::string_view prefix, std::format_string<Args...> message, Args&&... args
 	)
 	{
-		const auto logger    = GetCoreLogger();
-		auto       formatted = std::format(message, std::forward<Args>(args)...);
-		logger->error("{0}: {1}", prefix, formatted);
+		std::string& buffer = GetFormatBuffer(UntaggedID);
+		std::format_to(std::back_inserter(buffer), "{0}: ", prefix);
+		std::format_to(std::back_inserter(buffer), message, std::forward<Args>(args)...);
+		Write(type, Level::Error, buffer);
+
+		// Make sure the message is visible before a debug break
+		Flush();
 	}
 
 	inline void Log::PrintAssertMessage(Log::Type type, std::string_view prefix)
 	{
-		const auto logger = GetCoreLogger();
-		logger->error("{0}", prefix);
+		Write(type, Level::Error, prefix);
+		Flush();
 	}
 }        // namespace Eruption
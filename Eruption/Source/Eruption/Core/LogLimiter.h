@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace Eruption
+{
+	// Per call site state of the rate-limited logging macros. Every check is a single atomic
+	// operation in the common case, so it is safe to use on per-frame paths and from any thread.
+	class LogLimiter
+	{
+	public:
+		// True only for the first call
+		[[nodiscard]] bool ShouldLogOnce() { return !m_Logged.exchange(true, std::memory_order_relaxed); }
+
+		// True for the first call and every n-th one after it; no summary is needed as n - 1 calls are skipped
+		[[nodiscard]] bool ShouldLogEveryN(uint32_t n)
+		{
+			const uint64_t count = m_Count.fetch_add(1, std::memory_order_relaxed);
+			return n <= 1 || count % n == 0;
+		}
+
+		// True at most once per interval; suppressed receives the calls skipped since the last one
+		[[nodiscard]] bool ShouldLogRateLimited(uint32_t intervalMs, uint64_t& suppressed)
+		{
+			const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			                        std::chrono::steady_clock::now().time_since_epoch()
+			)
+			                        .count();
+			const int64_t interval = static_cast<int64_t>(intervalMs) * 1'000'000;
+
+			int64_t last = m_LastLogged.load(std::memory_order_relaxed);
+			if ((last != NeverLogged && now - last < interval) ||
+			    !m_LastLogged.compare_exchange_strong(last, now, std::memory_order_relaxed))
+			{
+				m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+
+	private:
+		static constexpr int64_t NeverLogged = std::numeric_limits<int64_t>::min();
+
+		std::atomic<bool>     m_Logged     = false;
+		std::atomic<uint64_t> m_Count      = 0;
+		std::atomic<int64_t>  m_LastLogged = NeverLogged;
+		std::atomic<uint64_t> m_Suppressed = 0;
+	};
+}        // namespace Eruption
@@ -1,7 +1,7 @@
 #pragma once
+#include "Eruption/Core/Clock.h"
 #include "Eruption/Core/Log.h"
 
-#include <chrono>
 #include <utility>
 
 namespace Eruption
@@ -10,26 +10,22 @@ namespace Eruption
 	{
 	public:
 		Timer() { Reset(); }
-		void Reset() { m_Start = std::chrono::high_resolution_clock::now(); }
+		void Reset() { m_Start = Clock::GetTicks(); }
 
-		[[nodiscard]] float Elapsed() const
-		{
-			using namespace std::chrono;
+		// Raw Clock ticks; prefer these in hot paths and convert once when reporting
+		[[nodiscard]] int64_t ElapsedTicks() const { return Clock::GetTicks() - m_Start; }
 
-			const auto end = high_resolution_clock::now();
-			return static_cast<float>(duration_cast<microseconds>(end - m_Start).count()) * 1e-6f;
-		}
+		[[nodiscard]] int64_t ElapsedNanoseconds() const { return Clock::ToNanoseconds(ElapsedTicks()); }
+
+		[[nodiscard]] float Elapsed() const { return static_cast<float>(Clock::ToSeconds(ElapsedTicks())); }
 
 		[[nodiscard]] float ElapsedMillis() const
 		{
-			using namespace std::chrono;
-
-			const auto end = high_resolution_clock::now();
-			return static_cast<float>(duration_cast<microseconds>(end - m_Start).count()) * 1e-3f;
+			return static_cast<float>(Clock::ToMilliseconds(ElapsedTicks()));
 		}
 
 	private:
-		std::chrono::time_point<std::chrono::high_resolution_clock> m_Start;
+		int64_t m_Start = 0;
 	};
 
 	class ScopedTimer
@@ -39,8 +35,7 @@ namespace Eruption
 
 		~ScopedTimer()
 		{
-			float time = m_Timer.ElapsedMillis();
-			ER_CORE_TRACE_TAG("Timer", "{0} - {1}ms", m_Name, time);
+			ER_CORE_TRACE_TAG("Timer", "{0} - {1}ms", m_Name, m_Timer.ElapsedMillis());
 		}
 
 	private:
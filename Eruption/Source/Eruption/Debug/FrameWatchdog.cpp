@@ -0,0 +1,161 @@
+#include "FrameWatchdog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <format>
+
+namespace Eruption
+{
+	namespace
+	{
+		// The reason ends up in the file name, anything but letters, digits, '.' and '-' becomes '_'
+		std::string SanitizeFileName(std::string_view name)
+		{
+			std::string result(name.empty() ? "Manual" : name);
+			for (char& c : result)
+			{
+				if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '-')
+					c = '_';
+			}
+			return result;
+		}
+	}        // namespace
+
+	FrameWatchdog::FrameWatchdog(const FrameWatchdogSpecification& specification) : m_Specification(specification)
+	{
+		m_Specification.WindowFrames = std::max(m_Specification.WindowFrames, 2u);
+
+		m_Frames.resize(m_Specification.WindowFrames);
+		m_MedianScratch.reserve(m_Specification.WindowFrames);
+
+		m_LastFrameEndNs = Profiler::GetTimestamp();
+	}
+
+	FrameWatchdog::~FrameWatchdog()
+	{
+		if (m_PendingDump.valid())
+			m_PendingDump.wait();
+	}
+
+	void FrameWatchdog::EndFrame(float cpuTimeMs)
+	{
+		const int64_t now = Profiler::GetTimestamp();
+
+		FrameRecord& record = m_Frames[m_NextFrame];
+		record.FrameIndex   = m_FrameIndex++;
+		record.StartNs      = m_LastFrameEndNs;
+		record.EndNs        = now;
+		record.CpuTimeMs    = cpuTimeMs;
+		record.Heap         = MemoryTracker::GetLastFrameStats();
+		record.VulkanCalls  = VulkanCallCounters::GetLastFrameStats();
+
+		m_LastFrameEndNs = now;
+		m_NextFrame      = (m_NextFrame + 1) % m_Frames.size();
+		m_FrameCount     = std::min(m_FrameCount + 1, m_Frames.size());
+
+		if (m_Cooldown > 0)
+		{
+			--m_Cooldown;
+			return;
+		}
+
+		// Wait for a full window so the median is meaningful
+		if (m_FrameCount < m_Frames.size() || m_DumpCount >= m_Specification.MaxDumps)
+			return;
+
+		const double frameTimeMs = record.GetFrameTimeMs();
+		if (frameTimeMs < m_Specification.MinSpikeMs)
+			return;
+
+		const double medianMs = GetMedianFrameTimeMs();
+		if (frameTimeMs < medianMs * m_Specification.SpikeFactor)
+			return;
+
+		ER_CORE_WARN_TAG(
+		    "Watchdog", "Frame {0} took {1:.2f}ms ({2:.2f}ms median)", record.FrameIndex, frameTimeMs, medianMs
+		);
+		Dump(std::format("{0:.1f}ms", frameTimeMs));
+	}
+
+	std::filesystem::path FrameWatchdog::Dump(std::string_view reason)
+	{
+		ER_PROFILE_FUNCTION();
+
+		const FrameRecord& last = m_Frames[(m_NextFrame + m_Frames.size() - 1) % m_Frames.size()];
+
+		const std::filesystem::path path =
+		    std::filesystem::path(m_Specification.OutputDirectory) /
+		    std::format("FrameSpike_{0}_{1}.json", last.FrameIndex, SanitizeFileName(reason));
+
+		m_Cooldown = m_Specification.CooldownFrames;
+
+		// A dump still being written means the system is struggling anyway; skip rather than queue up
+		if (m_PendingDump.valid() && m_PendingDump.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			ER_CORE_WARN_TAG("Watchdog", "Still writing the previous frame capture, skipping {0}", path.string());
+			return {};
+		}
+
+		++m_DumpCount;
+
+		m_PendingDump = std::async(std::launch::async, [capture = CaptureWindow(), path] {
+			std::error_code error;
+			std::filesystem::create_directories(path.parent_path(), error);
+
+			if (Profiler::WriteChromeTrace(capture, path))
+				ER_CORE_WARN_TAG("Watchdog", "Wrote frame capture to {0}", path.string());
+			else
+				ER_CORE_ERROR_TAG("Watchdog", "Failed to write frame capture to {0}", path.string());
+		});
+
+		return path;
+	}
+
+	double FrameWatchdog::GetMedianFrameTimeMs()
+	{
+		m_MedianScratch.clear();
+		for (size_t i = 0; i < m_FrameCount; ++i)
+			m_MedianScratch.push_back(m_Frames[i].GetFrameTimeMs());
+
+		const auto middle = m_MedianScratch.begin() + static_cast<ptrdiff_t>(m_MedianScratch.size() / 2);
+		std::ranges::nth_element(m_MedianScratch, middle);
+		return *middle;
+	}
+
+	ProfileCapture FrameWatchdog::CaptureWindow() const
+	{
+		const size_t oldest = (m_NextFrame + m_Frames.size() - m_FrameCount) % m_Frames.size();
+
+		ProfileCapture capture = Profiler::Capture(m_Frames[oldest].StartNs, m_LastFrameEndNs);
+
+		capture.Counters.reserve(m_FrameCount * (5 + VULKAN_CALL_COUNT));
+		for (size_t i = 0; i < m_FrameCount; ++i)
+		{
+			const FrameRecord& record = m_Frames[(oldest + i) % m_Frames.size()];
+
+			const auto addCounter = [&](const char* name, double value) {
+				capture.Counters.push_back({.Name = name, .TimestampNs = record.StartNs, .Value = value});
+			};
+
+			addCounter("Frame time (ms)", record.GetFrameTimeMs());
+			addCounter("CPU time (ms)", record.CpuTimeMs);
+
+			if constexpr (MemoryTracker::IsEnabled())
+			{
+				addCounter("Heap allocations", static_cast<double>(record.Heap.Allocations));
+				addCounter("Heap bytes allocated", static_cast<double>(record.Heap.Bytes));
+				addCounter("Heap live bytes", static_cast<double>(record.Heap.LiveBytes));
+			}
+
+			for (size_t call = 0; call < VULKAN_CALL_COUNT; ++call)
+			{
+				addCounter(
+				    VulkanCallCounters::GetName(static_cast<VulkanCall>(call)),
+				    static_cast<double>(record.VulkanCalls.Counts[call])
+				);
+			}
+		}
+
+		return capture;
+	}
+}        // namespace Eruption
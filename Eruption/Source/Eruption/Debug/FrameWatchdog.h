@@ -0,0 +1,83 @@
+#pragma once
+#include "Eruption/Debug/MemoryTracker.h"
+#include "Eruption/Debug/Profiler.h"
+#include "Eruption/Platform/Vulkan/VulkanCallCounters.h"
+
+#include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace Eruption
+{
+	struct FrameWatchdogSpecification
+	{
+		// Off in Dist, which compiles the profiler out: dumps would hold no zones
+#ifdef ER_ENABLE_PROFILING
+		bool        Enabled         = true;
+#else
+		bool        Enabled         = false;
+#endif
+		uint32_t    WindowFrames    = 300;          // Frames kept in memory and written per dump
+		float       SpikeFactor     = 2.0f;         // Threshold relative to the median frame time of the window
+		float       MinSpikeMs      = 5.0f;         // Frames faster than this never count as spikes
+		uint32_t    CooldownFrames  = 300;          // Frames after a dump before the next one can trigger
+		uint32_t    MaxDumps        = 10;           // Per run, so a slow machine does not fill the disk
+		std::string OutputDirectory = "Captures";
+	};
+
+	struct FrameRecord
+	{
+		uint64_t         FrameIndex = 0;
+		int64_t          StartNs    = 0;        // On the profiler clock
+		int64_t          EndNs      = 0;
+		float            CpuTimeMs  = 0.0f;
+		MemoryFrameStats Heap;
+		VulkanCallStats  VulkanCalls;
+
+		[[nodiscard]] double GetFrameTimeMs() const { return static_cast<double>(EndNs - StartNs) * 1e-6; }
+	};
+
+	// Keeps the last WindowFrames frames of statistics and, through the always-on profiler, their zones. When a
+	// frame takes longer than SpikeFactor times the window median, the whole window is written as a Chrome
+	// trace with the frame statistics as counter tracks, so rare spikes leave evidence behind.
+	class FrameWatchdog
+	{
+	public:
+		explicit FrameWatchdog(const FrameWatchdogSpecification& specification);
+		~FrameWatchdog();
+
+		FrameWatchdog(const FrameWatchdog&)            = delete;
+		FrameWatchdog& operator=(const FrameWatchdog&) = delete;
+
+		// Called by the application loop at the end of every frame
+		void EndFrame(float cpuTimeMs);
+
+		// Writes the current window regardless of the threshold; returns the trace path
+		std::filesystem::path Dump(std::string_view reason);
+
+		[[nodiscard]] const FrameWatchdogSpecification& GetSpecification() const { return m_Specification; }
+		[[nodiscard]] uint32_t                          GetDumpCount() const { return m_DumpCount; }
+
+	private:
+		[[nodiscard]] double GetMedianFrameTimeMs();
+
+		[[nodiscard]] ProfileCapture CaptureWindow() const;
+
+	private:
+		FrameWatchdogSpecification m_Specification;
+
+		std::vector<FrameRecord> m_Frames;        // Ring buffer
+		size_t                   m_NextFrame  = 0;
+		size_t                   m_FrameCount = 0;
+		std::vector<double>      m_MedianScratch;
+
+		int64_t  m_LastFrameEndNs = 0;
+		uint64_t m_FrameIndex     = 0;
+		uint32_t m_Cooldown       = 0;
+		uint32_t m_DumpCount      = 0;
+
+		// Traces are written off the main thread so the dump does not cause a spike of its own
+		std::future<void> m_PendingDump;
+	};
+}        // namespace Eruption
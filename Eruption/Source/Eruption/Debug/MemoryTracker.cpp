@@ -0,0 +1,456 @@
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <ranges>
+#include <string_view>
+#include <unordered_map>
+
+namespace Eruption
+{
+	namespace
+	{
+		constexpr uint32_t UNTAGGED_INDEX = 0;
+
+		// Placed right before every block handed out, so Free knows the size and tag without a lookup
+		struct alignas(16) AllocationHeader
+		{
+			uint64_t Size;
+			uint32_t TagIndex;
+			uint32_t Offset;        // From the start of the malloc block to the user pointer
+		};
+		static_assert(sizeof(AllocationHeader) == 16);
+
+		struct TagEntry
+		{
+			std::atomic<const char*> Tag = nullptr;
+
+			std::atomic<int64_t>  LiveBytes            = 0;
+			std::atomic<int64_t>  LiveAllocations      = 0;
+			std::atomic<uint64_t> FrameAllocations     = 0;
+			std::atomic<uint64_t> FrameBytes           = 0;
+			std::atomic<uint64_t> LastFrameAllocations = 0;
+			std::atomic<uint64_t> LastFrameBytes       = 0;
+		};
+
+		// Constant-initialized, so allocations made during static initialization are tracked too
+		constinit std::array<TagEntry, MemoryTracker::MaxTags> s_Tags{};
+
+		constinit std::atomic<uint64_t> s_FrameAllocations = 0;
+		constinit std::atomic<uint64_t> s_FrameBytes       = 0;
+		constinit std::atomic<uint64_t> s_FrameFrees       = 0;
+		constinit std::atomic<int64_t>  s_LiveBytes        = 0;
+
+		constinit std::atomic<uint64_t> s_LastFrameAllocations = 0;
+		constinit std::atomic<uint64_t> s_LastFrameBytes       = 0;
+		constinit std::atomic<uint64_t> s_LastFrameFrees       = 0;
+		constinit std::atomic<int64_t>  s_LastFrameLiveBytes   = 0;
+
+		// Open addressing on the tag address; once the table is full new tags count as untagged
+		uint32_t FindTagIndex(const char* tag)
+		{
+			if (!tag)
+				return UNTAGGED_INDEX;
+
+			constexpr uint32_t slots = MemoryTracker::MaxTags - 1;
+
+			const auto hash = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(tag) >> 3) * 2654435761u);
+			for (uint32_t probe = 0; probe < slots; ++probe)
+			{
+				const uint32_t index = 1 + (hash + probe) % slots;
+				TagEntry&      entry = s_Tags[index];
+
+				const char* current = entry.Tag.load(std::memory_order_acquire);
+				if (current == tag)
+					return index;
+
+				if (!current && entry.Tag.compare_exchange_strong(current, tag, std::memory_order_acq_rel))
+					return index;
+				if (current == tag)
+					return index;
+			}
+
+			return UNTAGGED_INDEX;
+		}
+
+		// Strips the GetMemoryTypeTag signature down to the type name
+		std::string_view GetDisplayName(std::string_view tag)
+		{
+#ifdef ER_PLATFORM_WINDOWS
+			constexpr std::string_view prefix = "GetMemoryTypeTag<";
+			constexpr std::string_view suffix = ">(void)";
+#else
+			constexpr std::string_view prefix = "[with T = ";
+			constexpr std::string_view suffix = "]";
+#endif
+			if (!tag.contains("GetMemoryTypeTag"))
+				return tag;
+
+			const size_t begin = tag.find(prefix);
+			const size_t end   = tag.rfind(suffix);
+			if (begin == std::string_view::npos || end == std::string_view::npos || end < begin + prefix.size())
+				return tag;
+
+			return tag.substr(begin + prefix.size(), end - begin - prefix.size());
+		}
+	}        // namespace
+
+	MemoryTracker::ThreadTags& MemoryTracker::GetThreadTags()
+	{
+		thread_local constinit ThreadTags tags{};
+		return tags;
+	}
+
+	const char* MemoryTracker::GetCurrentTag()
+	{
+		const ThreadTags& tags = GetThreadTags();
+
+		if (tags.Depth > 0)
+			return tags.Tags[std::min(tags.Depth, MaxTagDepth) - 1];
+		return tags.Zone ? tags.Zone : tags.Type;
+	}
+
+	void* MemoryTracker::Allocate(size_t size, size_t alignment)
+	{
+		alignment = std::max(alignment, alignof(AllocationHeader));
+
+		// Only over-aligned requests need slack to move the user pointer forward
+		const size_t slack = alignment > alignof(AllocationHeader) ? alignment - 1 : 0;
+
+		// The total would wrap for huge sizes, and the header would then be written past a tiny block
+		if (size > std::numeric_limits<size_t>::max() - sizeof(AllocationHeader) - slack)
+			return nullptr;
+
+		void* block = std::malloc(size + sizeof(AllocationHeader) + slack);
+		if (!block)
+			return nullptr;
+
+		const uintptr_t blockAddress = reinterpret_cast<uintptr_t>(block);
+		const uintptr_t userAddress  = (blockAddress + sizeof(AllocationHeader) + alignment - 1) & ~(alignment - 1);
+
+		const uint32_t tagIndex = FindTagIndex(GetCurrentTag());
+
+		auto* header     = reinterpret_cast<AllocationHeader*>(userAddress - sizeof(AllocationHeader));
+		header->Size     = size;
+		header->TagIndex = tagIndex;
+		header->Offset   = static_cast<uint32_t>(userAddress - blockAddress);
+
+		TagEntry& entry = s_Tags[tagIndex];
+		entry.LiveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+		entry.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+		entry.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+		entry.FrameBytes.fetch_add(size, std::memory_order_relaxed);
+
+		s_FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+		s_FrameBytes.fetch_add(size, std::memory_order_relaxed);
+		s_LiveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+
+		return reinterpret_cast<void*>(userAddress);
+	}
+
+	void MemoryTracker::Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		const uintptr_t userAddress = reinterpret_cast<uintptr_t>(memory);
+		const auto*     header      = reinterpret_cast<const AllocationHeader*>(userAddress - sizeof(AllocationHeader));
+
+		const auto size = static_cast<int64_t>(header->Size);
+
+		TagEntry& entry = s_Tags[header->TagIndex];
+		entry.LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+		entry.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+		s_FrameFrees.fetch_add(1, std::memory_order_relaxed);
+		s_LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+
+		std::free(reinterpret_cast<void*>(userAddress - header->Offset));
+	}
+
+	void MemoryTracker::PushTag(const char* tag)
+	{
+		ThreadTags& tags = GetThreadTags();
+
+		// Tags nested deeper than the stack are dropped but still counted so pops stay balanced
+		if (tags.Depth < MaxTagDepth)
+			tags.Tags[tags.Depth] = tag;
+		++tags.Depth;
+	}
+
+	void MemoryTracker::PopTag()
+	{
+		ThreadTags& tags = GetThreadTags();
+		ER_CORE_ASSERT(tags.Depth > 0, "Unbalanced memory tag pop!");
+		--tags.Depth;
+	}
+
+	void MemoryTracker::MarkFrame()
+	{
+		if constexpr (!IsEnabled())
+			return;
+
+		const auto closeCounter = [](std::atomic<uint64_t>& counter, std::atomic<uint64_t>& last) {
+			last.store(counter.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		};
+
+		for (TagEntry& entry : s_Tags)
+		{
+			closeCounter(entry.FrameAllocations, entry.LastFrameAllocations);
+			closeCounter(entry.FrameBytes, entry.LastFrameBytes);
+		}
+
+		closeCounter(s_FrameAllocations, s_LastFrameAllocations);
+		closeCounter(s_FrameBytes, s_LastFrameBytes);
+		closeCounter(s_FrameFrees, s_LastFrameFrees);
+		s_LastFrameLiveBytes.store(s_LiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	MemoryFrameStats MemoryTracker::GetLastFrameStats()
+	{
+		return {
+		    .Allocations = s_LastFrameAllocations.load(std::memory_order_relaxed),
+		    .Bytes       = s_LastFrameBytes.load(std::memory_order_relaxed),
+		    .Frees       = s_LastFrameFrees.load(std::memory_order_relaxed),
+		    .LiveBytes   = s_LastFrameLiveBytes.load(std::memory_order_relaxed)
+		};
+	}
+
+	std::vector<MemoryTagStats> MemoryTracker::GetTagStats()
+	{
+		// Identical names at different addresses, e.g. the same literal in two modules, are merged
+		std::unordered_map<std::string_view, MemoryTagStats> merged;
+
+		for (uint32_t index = 0; index < MaxTags; ++index)
+		{
+			const TagEntry& entry = s_Tags[index];
+			const char*     tag   = index == UNTAGGED_INDEX ? "Untagged" : entry.Tag.load(std::memory_order_acquire);
+			if (!tag)
+				continue;
+
+			const std::string_view name  = GetDisplayName(tag);
+			MemoryTagStats&        stats = merged[name];
+			stats.LiveBytes += entry.LiveBytes.load(std::memory_order_relaxed);
+			stats.LiveAllocations += entry.LiveAllocations.load(std::memory_order_relaxed);
+			stats.FrameAllocations += entry.LastFrameAllocations.load(std::memory_order_relaxed);
+			stats.FrameBytes += entry.LastFrameBytes.load(std::memory_order_relaxed);
+		}
+
+		std::vector<MemoryTagStats> result;
+		result.reserve(merged.size());
+		for (auto& [name, stats] : merged)
+		{
+			if (stats.LiveAllocations == 0 && stats.FrameAllocations == 0)
+				continue;
+
+			stats.Tag = name;
+			result.push_back(std::move(stats));
+		}
+
+		std::ranges::sort(result, std::ranges::greater{}, &MemoryTagStats::LiveBytes);
+		return result;
+	}
+
+	void MemoryTracker::LogReport(uint32_t maxTags)
+	{
+		if constexpr (!IsEnabled())
+		{
+			ER_CORE_WARN_TAG("Memory", "Memory tracking is disabled, configure with ERUPTION_MEMORY_TRACKING=ON");
+			return;
+		}
+
+		// Unused when info logging is compiled out
+		[[maybe_unused]] const MemoryFrameStats frame = GetLastFrameStats();
+		ER_CORE_INFO_TAG(
+		    "Memory",
+		    "Last frame: {0} allocations, {1} bytes, {2} frees; {3} bytes live",
+		    frame.Allocations,
+		    frame.Bytes,
+		    frame.Frees,
+		    frame.LiveBytes
+		);
+
+		std::vector<MemoryTagStats> tags = GetTagStats();
+
+		ER_CORE_INFO_TAG("Memory", "Live bytes by tag:");
+		for ([[maybe_unused]] const MemoryTagStats& stats : tags | std::views::take(maxTags))
+		{
+			ER_CORE_INFO_TAG(
+			    "Memory", "  {0}: {1} bytes in {2} allocations", stats.Tag, stats.LiveBytes, stats.LiveAllocations
+			);
+		}
+
+		std::ranges::sort(tags, std::ranges::greater{}, &MemoryTagStats::FrameAllocations);
+
+		ER_CORE_INFO_TAG("Memory", "Allocations last frame by tag:");
+		for (const MemoryTagStats& stats : tags | std::views::take(maxTags))
+		{
+			if (stats.FrameAllocations == 0)
+				break;
+			ER_CORE_INFO_TAG(
+			    "Memory", "  {0}: {1} allocations, {2} bytes", stats.Tag, stats.FrameAllocations, stats.FrameBytes
+			);
+		}
+	}
+
+	MemoryZoneScope::MemoryZoneScope(const char* zone) : m_Previous(MemoryTracker::GetThreadTags().Zone)
+	{
+		MemoryTracker::GetThreadTags().Zone = zone;
+	}
+
+	MemoryZoneScope::~MemoryZoneScope()
+	{
+		MemoryTracker::GetThreadTags().Zone = m_Previous;
+	}
+
+	MemoryTypeScope::MemoryTypeScope(const char* type) : m_Previous(MemoryTracker::GetThreadTags().Type)
+	{
+		// The outermost type wins, so members allocated by a constructor count towards the created object
+		if (!m_Previous)
+			MemoryTracker::GetThreadTags().Type = type;
+	}
+
+	MemoryTypeScope::~MemoryTypeScope()
+	{
+		MemoryTracker::GetThreadTags().Type = m_Previous;
+	}
+}        // namespace Eruption
+
+#ifdef ER_ENABLE_MEMORY_TRACKING
+
+// Global replacements. On Linux they interpose for the whole process; on Windows they cover allocations made
+// by code in the engine library itself.
+namespace
+{
+	void* AllocateOrThrow(size_t size, size_t alignment)
+	{
+		while (true)
+		{
+			if (void* memory = Eruption::MemoryTracker::Allocate(size, alignment))
+				return memory;
+
+			const std::new_handler handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc();
+			handler();
+		}
+	}
+
+	void* AllocateNoThrow(size_t size, size_t alignment) noexcept
+	{
+		try
+		{
+			return AllocateOrThrow(size, alignment);
+		}
+		catch (...)
+		{
+			return nullptr;
+		}
+	}
+}        // namespace
+
+void* operator new(size_t size)
+{
+	return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size)
+{
+	return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocateNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocateNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateNoThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateNoThrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	Eruption::MemoryTracker::Free(memory);
+}
+
+#endif
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Enabled with the ERUPTION_MEMORY_TRACKING CMake option, which replaces the global operator new/delete.
+// Not available on Windows: each module has its own operator new, so Free would see blocks it did not allocate.
+#if defined(ER_ENABLE_MEMORY_TRACKING) && defined(ER_PLATFORM_WINDOWS)
+#	error "Memory tracking is not supported on Windows"
+#endif
+
+#ifdef ER_ENABLE_MEMORY_TRACKING
+#	define ER_MEMORY_TRACKING_ENABLED 1
+#else
+#	define ER_MEMORY_TRACKING_ENABLED 0
+#endif
+
+namespace Eruption
+{
+	struct MemoryTagStats
+	{
+		std::string Tag;
+		int64_t     LiveBytes        = 0;
+		int64_t     LiveAllocations  = 0;
+		uint64_t    FrameAllocations = 0;        // During the last completed frame
+		uint64_t    FrameBytes       = 0;
+	};
+
+	struct MemoryFrameStats
+	{
+		uint64_t Allocations = 0;
+		uint64_t Bytes       = 0;
+		uint64_t Frees       = 0;
+		int64_t  LiveBytes   = 0;        // At the end of the frame
+	};
+
+	// Heap allocation tracker. Every allocation is attributed to the innermost explicit tag of the allocating
+	// thread, or else its current profiler zone, or else the type created by CreateRef/CreateScope. Counters
+	// live in a fixed table of atomics, so the allocation hooks never allocate or lock themselves.
+	class MemoryTracker
+	{
+	public:
+		static constexpr uint32_t MaxTags     = 512;
+		static constexpr uint32_t MaxTagDepth = 32;
+
+		[[nodiscard]] static constexpr bool IsEnabled() { return ER_MEMORY_TRACKING_ENABLED; }
+
+		// Used by the operator new/delete replacements; memory must be released with Free
+		[[nodiscard]] static void* Allocate(size_t size, size_t alignment);
+		static void                Free(void* memory);
+
+		// Tags must be string literals or otherwise outlive the tracker, they are compared by address
+		static void PushTag(const char* tag);
+		static void PopTag();
+
+		// Closes the per-frame counters, called once per frame by the application loop
+		static void MarkFrame();
+
+		[[nodiscard]] static MemoryFrameStats GetLastFrameStats();
+
+		// One entry per tag name, sorted by live bytes
+		[[nodiscard]] static std::vector<MemoryTagStats> GetTagStats();
+
+		// Logs the tags with the most live bytes and the most allocations last frame
+		static void LogReport(uint32_t maxTags = 10);
+
+	private:
+		struct ThreadTags
+		{
+			const char* Tags[MaxTagDepth] = {};
+			uint32_t    Depth             = 0;
+			const char* Zone              = nullptr;
+			const char* Type              = nullptr;
+		};
+
+		[[nodiscard]] static ThreadTags& GetThreadTags();
+		[[nodiscard]] static const char* GetCurrentTag();
+
+		friend class MemoryZoneScope;
+		friend class MemoryTypeScope;
+	};
+
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(const char* tag) { MemoryTracker::PushTag(tag); }
+		~MemoryTagScope() { MemoryTracker::PopTag(); }
+
+		MemoryTagScope(const MemoryTagScope&)            = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+	};
+
+	// Attribution fallbacks, set by profiler zones and the pointer helpers in Base.h
+	class MemoryZoneScope
+	{
+	public:
+		explicit MemoryZoneScope(const char* zone);
+		~MemoryZoneScope();
+
+		MemoryZoneScope(const MemoryZoneScope&)            = delete;
+		MemoryZoneScope& operator=(const MemoryZoneScope&) = delete;
+
+	private:
+		const char* m_Previous;
+	};
+
+	class MemoryTypeScope
+	{
+	public:
+		explicit MemoryTypeScope(const char* type);
+		~MemoryTypeScope();
+
+		MemoryTypeScope(const MemoryTypeScope&)            = delete;
+		MemoryTypeScope& operator=(const MemoryTypeScope&) = delete;
+
+	private:
+		const char* m_Previous;
+	};
+
+	// A stable, per-type string naming T; trimmed to the type name when reported
+	template <typename T>
+	[[nodiscard]] const char* GetMemoryTypeTag()
+	{
+#ifdef ER_PLATFORM_WINDOWS
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+}        // namespace Eruption
+
+#ifdef ER_ENABLE_MEMORY_TRACKING
+#	define ER_MEMORY_TAG_CONCAT_INTERNAL(a, b) a##b
+#	define ER_MEMORY_TAG_CONCAT(a, b) ER_MEMORY_TAG_CONCAT_INTERNAL(a, b)
+#	define ER_MEMORY_TAG(tag) ::Eruption::MemoryTagScope ER_MEMORY_TAG_CONCAT(erMemoryTagScope, __LINE__)(tag)
+#else
+#	define ER_MEMORY_TAG(tag)
+#endif
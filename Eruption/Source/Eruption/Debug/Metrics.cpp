@@ -0,0 +1,468 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace Eruption
+{
+	namespace
+	{
+		struct MetricEntry
+		{
+			std::string Name;
+			std::string Help;
+			MetricType  Type;
+
+			Scope<MetricCounter>   Counter;
+			Scope<MetricGauge>     Gauge;
+			Scope<MetricHistogram> Histogram;
+		};
+
+		struct PerFrameCounter
+		{
+			MetricCounter*   Counter;
+			MetricHistogram* Histogram;
+			uint64_t         LastValue;
+		};
+
+		struct Registry
+		{
+			std::mutex                                    Mutex;
+			std::vector<Scope<MetricEntry>>               Entries;        // In registration order
+			std::unordered_map<std::string, MetricEntry*> Lookup;
+			std::vector<PerFrameCounter>                  PerFrameCounters;
+
+			std::mutex                  PublisherMutex;
+			std::condition_variable_any PublisherCondition;
+			std::jthread                Publisher;
+		};
+
+		// Never destroyed, metrics cached in statics may still be updated during static destruction
+		Registry& GetRegistry()
+		{
+			static Registry* registry = new Registry();
+			return *registry;
+		}
+
+		bool IsValidMetricName(std::string_view name)
+		{
+			const auto isStart = [](char c) {
+				return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+			};
+			return !name.empty() && isStart(name.front()) &&
+			       std::ranges::all_of(name, [&](char c) { return isStart(c) || (c >= '0' && c <= '9'); });
+		}
+
+		MetricEntry& Register(std::string_view name, std::string_view help, MetricType type)
+		{
+			ER_CORE_ASSERT(IsValidMetricName(name), "Invalid metric name!");
+
+			Registry&       registry = GetRegistry();
+			std::lock_guard lock(registry.Mutex);
+
+			if (const auto it = registry.Lookup.find(std::string(name)); it != registry.Lookup.end())
+			{
+				ER_CORE_ASSERT(it->second->Type == type, "Metric registered again with a different type!");
+				return *it->second;
+			}
+
+			auto entry  = CreateScope<MetricEntry>();
+			entry->Name = name;
+			entry->Help = help;
+			entry->Type = type;
+
+			switch (type)
+			{
+				case MetricType::Counter:   entry->Counter = CreateScope<MetricCounter>(); break;
+				case MetricType::Gauge:     entry->Gauge = CreateScope<MetricGauge>(); break;
+				case MetricType::Histogram: entry->Histogram = CreateScope<MetricHistogram>(); break;
+			}
+
+			MetricEntry& result = *entry;
+			registry.Lookup.emplace(entry->Name, &result);
+			registry.Entries.push_back(std::move(entry));
+
+			return result;
+		}
+
+		void AppendEscaped(std::string& out, std::string_view string, bool json)
+		{
+			for (const char c : string)
+			{
+				switch (c)
+				{
+					case '\\': out.append("\\\\"); break;
+					case '\n': out.append("\\n"); break;
+					case '"':
+					{
+						out.append(json ? "\\\"" : "\"");
+						break;
+					}
+					default:
+					{
+						if (json && static_cast<unsigned char>(c) < 0x20)
+							std::format_to(std::back_inserter(out), "\\u{0:04x}", static_cast<uint32_t>(c));
+						else
+							out.push_back(c);
+						break;
+					}
+				}
+			}
+		}
+
+		std::string_view ToString(MetricType type)
+		{
+			switch (type)
+			{
+				case MetricType::Counter:   return "counter";
+				case MetricType::Gauge:     return "gauge";
+				case MetricType::Histogram: return "histogram";
+			}
+			return "untyped";
+		}
+	}        // namespace
+
+	uint32_t Internal::GetMetricShard()
+	{
+		static std::atomic<uint32_t> s_NextShard = 0;
+		thread_local const uint32_t  shard       = s_NextShard.fetch_add(1, std::memory_order_relaxed);
+		return shard % METRIC_SHARD_COUNT;
+	}
+
+	uint64_t MetricCounter::GetValue() const
+	{
+		uint64_t value = 0;
+		for (const Shard& shard : m_Shards)
+			value += shard.Value.load(std::memory_order_relaxed);
+		return value;
+	}
+
+	void MetricHistogram::Record(uint64_t value)
+	{
+		Shard& shard = m_Shards[Internal::GetMetricShard()];
+		shard.Buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		shard.Count.fetch_add(1, std::memory_order_relaxed);
+		shard.Sum.fetch_add(value, std::memory_order_relaxed);
+
+		uint64_t max = m_Max.load(std::memory_order_relaxed);
+		while (value > max && !m_Max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+		{}
+	}
+
+	HistogramSummary MetricHistogram::Summarize() const
+	{
+		std::array<uint64_t, BucketCount> buckets{};
+
+		HistogramSummary summary;
+		for (const Shard& shard : m_Shards)
+		{
+			for (uint32_t i = 0; i < BucketCount; ++i)
+				buckets[i] += shard.Buckets[i].load(std::memory_order_relaxed);
+			summary.Sum += static_cast<double>(shard.Sum.load(std::memory_order_relaxed));
+		}
+
+		// Counted from the buckets so the quantiles are consistent with them while writers keep recording
+		for (const uint64_t count : buckets)
+			summary.Count += count;
+		summary.Max = m_Max.load(std::memory_order_relaxed);
+
+		if (summary.Count == 0)
+			return summary;
+
+		const auto quantile = [&](double q) {
+			const auto rank =
+			    std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(summary.Count) + 0.5));
+
+			uint64_t cumulative = 0;
+			for (uint32_t i = 0; i < BucketCount; ++i)
+			{
+				cumulative += buckets[i];
+				if (cumulative >= rank)
+				{
+					const double midpoint = (static_cast<double>(GetBucketLowerBound(i)) +
+					                         static_cast<double>(GetBucketUpperBound(i))) * 0.5;
+					return std::min(midpoint, static_cast<double>(summary.Max));
+				}
+			}
+			return static_cast<double>(summary.Max);
+		};
+
+		summary.P50 = quantile(0.5);
+		summary.P90 = quantile(0.9);
+		summary.P99 = quantile(0.99);
+
+		return summary;
+	}
+
+	uint32_t MetricHistogram::GetBucketIndex(uint64_t value)
+	{
+		if (value < SubBuckets)
+			return static_cast<uint32_t>(value);
+
+		const auto     shift = static_cast<uint32_t>(std::bit_width(value)) - 1 - SubBucketBits;
+		const uint64_t sub   = (value >> shift) & (SubBuckets - 1);
+		return SubBuckets + shift * SubBuckets + static_cast<uint32_t>(sub);
+	}
+
+	uint64_t MetricHistogram::GetBucketLowerBound(uint32_t index)
+	{
+		if (index < SubBuckets)
+			return index;
+
+		const uint32_t shift = (index - SubBuckets) / SubBuckets;
+		const uint32_t sub   = (index - SubBuckets) % SubBuckets;
+		return static_cast<uint64_t>(SubBuckets + sub) << shift;
+	}
+
+	uint64_t MetricHistogram::GetBucketUpperBound(uint32_t index)
+	{
+		if (index < SubBuckets)
+			return index;
+
+		const uint32_t shift = (index - SubBuckets) / SubBuckets;
+		return GetBucketLowerBound(index) + ((uint64_t{1} << shift) - 1);
+	}
+
+	MetricCounter& Metrics::GetCounter(std::string_view name, std::string_view help)
+	{
+		return *Register(name, help, MetricType::Counter).Counter;
+	}
+
+	MetricGauge& Metrics::GetGauge(std::string_view name, std::string_view help)
+	{
+		return *Register(name, help, MetricType::Gauge).Gauge;
+	}
+
+	MetricHistogram& Metrics::GetHistogram(std::string_view name, std::string_view help)
+	{
+		return *Register(name, help, MetricType::Histogram).Histogram;
+	}
+
+	MetricCounter& Metrics::GetPerFrameCounter(std::string_view name, std::string_view help)
+	{
+		// eruption_queue_submits_total is tracked as eruption_queue_submits_per_frame
+		std::string_view baseName = name;
+		if (baseName.ends_with("_total"))
+			baseName.remove_suffix(std::string_view("_total").size());
+
+		MetricCounter&   counter = GetCounter(name, help);
+		MetricHistogram& histogram =
+		    GetHistogram(std::format("{0}_per_frame", baseName), std::format("{0}, per frame", help));
+
+		Registry&       registry = GetRegistry();
+		std::lock_guard lock(registry.Mutex);
+
+		const bool tracked = std::ranges::any_of(registry.PerFrameCounters, [&](const PerFrameCounter& perFrame) {
+			return perFrame.Counter == &counter;
+		});
+		if (!tracked)
+		{
+			registry.PerFrameCounters.push_back(
+			    {.Counter = &counter, .Histogram = &histogram, .LastValue = counter.GetValue()}
+			);
+		}
+
+		return counter;
+	}
+
+	void Metrics::MarkFrame()
+	{
+		Registry&       registry = GetRegistry();
+		std::lock_guard lock(registry.Mutex);
+
+		for (PerFrameCounter& perFrame : registry.PerFrameCounters)
+		{
+			const uint64_t value = perFrame.Counter->GetValue();
+			perFrame.Histogram->Record(value - perFrame.LastValue);
+			perFrame.LastValue = value;
+		}
+	}
+
+	MetricsSnapshot Metrics::Snapshot()
+	{
+		MetricsSnapshot snapshot;
+		snapshot.TimestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+		                           std::chrono::system_clock::now().time_since_epoch()
+		)
+		                           .count();
+
+		Registry&       registry = GetRegistry();
+		std::lock_guard lock(registry.Mutex);
+
+		snapshot.Metrics.reserve(registry.Entries.size());
+		for (const Scope<MetricEntry>& entry : registry.Entries)
+		{
+			MetricSnapshot& metric = snapshot.Metrics.emplace_back();
+			metric.Name            = entry->Name;
+			metric.Help            = entry->Help;
+			metric.Type            = entry->Type;
+
+			switch (entry->Type)
+			{
+				case MetricType::Counter:   metric.Value = static_cast<double>(entry->Counter->GetValue()); break;
+				case MetricType::Gauge:     metric.Value = static_cast<double>(entry->Gauge->GetValue()); break;
+				case MetricType::Histogram: metric.Summary = entry->Histogram->Summarize(); break;
+			}
+		}
+
+		return snapshot;
+	}
+
+	std::string Metrics::FormatPrometheus(const MetricsSnapshot& snapshot)
+	{
+		std::string out;
+		auto        inserter = std::back_inserter(out);
+
+		const auto writeHeader = [&](std::string_view name, std::string_view help, std::string_view type) {
+			if (!help.empty())
+			{
+				std::format_to(inserter, "# HELP {0} ", name);
+				AppendEscaped(out, help, false);
+				out.push_back('\n');
+			}
+			std::format_to(inserter, "# TYPE {0} {1}\n", name, type);
+		};
+
+		for (const MetricSnapshot& metric : snapshot.Metrics)
+		{
+			if (metric.Type != MetricType::Histogram)
+			{
+				writeHeader(metric.Name, metric.Help, ToString(metric.Type));
+				std::format_to(inserter, "{0} {1}\n", metric.Name, metric.Value);
+				continue;
+			}
+
+			// Histograms are exposed as summaries, the log-linear buckets would make for hundreds of series
+			const HistogramSummary& summary = metric.Summary;
+			writeHeader(metric.Name, metric.Help, "summary");
+			std::format_to(inserter, "{0}{{quantile=\"0.5\"}} {1}\n", metric.Name, summary.P50);
+			std::format_to(inserter, "{0}{{quantile=\"0.9\"}} {1}\n", metric.Name, summary.P90);
+			std::format_to(inserter, "{0}{{quantile=\"0.99\"}} {1}\n", metric.Name, summary.P99);
+			std::format_to(inserter, "{0}_sum {1}\n", metric.Name, summary.Sum);
+			std::format_to(inserter, "{0}_count {1}\n", metric.Name, summary.Count);
+
+			const std::string maxName = std::format("{0}_max", metric.Name);
+			writeHeader(maxName, {}, "gauge");
+			std::format_to(inserter, "{0} {1}\n", maxName, summary.Max);
+		}
+
+		return out;
+	}
+
+	std::string Metrics::FormatJson(const MetricsSnapshot& snapshot)
+	{
+		std::string out;
+		auto        inserter = std::back_inserter(out);
+
+		std::format_to(inserter, "{{\"timestamp_ms\":{0},\"metrics\":[", snapshot.TimestampMs);
+
+		for (size_t i = 0; i < snapshot.Metrics.size(); ++i)
+		{
+			const MetricSnapshot& metric = snapshot.Metrics[i];
+
+			out.append(i == 0 ? "\n{\"name\":\"" : ",\n{\"name\":\"");
+			AppendEscaped(out, metric.Name, true);
+			out.append("\",\"help\":\"");
+			AppendEscaped(out, metric.Help, true);
+			std::format_to(inserter, "\",\"type\":\"{0}\",", ToString(metric.Type));
+
+			if (metric.Type != MetricType::Histogram)
+			{
+				std::format_to(inserter, "\"value\":{0}}}", metric.Value);
+				continue;
+			}
+
+			const HistogramSummary& summary = metric.Summary;
+			std::format_to(
+			    inserter,
+			    "\"count\":{0},\"sum\":{1},\"p50\":{2},\"p90\":{3},\"p99\":{4},\"max\":{5}}}",
+			    summary.Count,
+			    summary.Sum,
+			    summary.P50,
+			    summary.P90,
+			    summary.P99,
+			    summary.Max
+			);
+		}
+
+		out.append("\n]}\n");
+		return out;
+	}
+
+	bool Metrics::WriteSnapshot(const std::filesystem::path& path, MetricsFormat format)
+	{
+		const MetricsSnapshot snapshot = Snapshot();
+		const std::string     contents =
+		    format == MetricsFormat::Json ? FormatJson(snapshot) : FormatPrometheus(snapshot);
+
+		std::error_code error;
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+
+		{
+			std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+				return false;
+
+			stream << contents;
+			if (!stream.good())
+				return false;
+		}
+
+		std::filesystem::rename(temporaryPath, path, error);
+		return !error;
+	}
+
+	void Metrics::StartPublishing(const MetricsSpecification& specification)
+	{
+		StopPublishing();
+
+		Registry& registry = GetRegistry();
+		registry.Publisher = std::jthread([specification, &registry](std::stop_token stopToken) {
+			Profiler::SetThreadName("Metrics");
+
+			const auto interval = std::chrono::milliseconds(std::max(specification.IntervalMs, 100u));
+
+			bool reportedFailure = false;
+			while (!stopToken.stop_requested())
+			{
+				if (!WriteSnapshot(specification.OutputPath, specification.Format) && !reportedFailure)
+				{
+					ER_CORE_ERROR_TAG("Metrics", "Failed to write metrics snapshot to {0}", specification.OutputPath);
+					reportedFailure = true;
+				}
+
+				std::unique_lock lock(registry.PublisherMutex);
+				registry.PublisherCondition.wait_for(lock, stopToken, interval, [] { return false; });
+			}
+
+			// Leave the final state behind for the last scrape
+			WriteSnapshot(specification.OutputPath, specification.Format);
+		});
+
+		ER_CORE_INFO_TAG(
+		    "Metrics", "Publishing metrics to {0} every {1}ms", specification.OutputPath, specification.IntervalMs
+		);
+	}
+
+	void Metrics::StopPublishing()
+	{
+		Registry& registry = GetRegistry();
+		if (!registry.Publisher.joinable())
+			return;
+
+		registry.Publisher.request_stop();
+		registry.Publisher.join();
+	}
+}        // namespace Eruption
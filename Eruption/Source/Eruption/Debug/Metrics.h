@@ -0,0 +1,162 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Eruption
+{
+	namespace Internal
+	{
+		inline constexpr uint32_t METRIC_SHARD_COUNT = 8;
+
+		// Threads are spread over the shards round-robin, so concurrent updates rarely share a cache line
+		[[nodiscard]] uint32_t GetMetricShard();
+	}        // namespace Internal
+
+	// Monotonically increasing count, e.g. events dispatched. Increments go to a per-thread shard.
+	class MetricCounter
+	{
+	public:
+		void Increment(uint64_t amount = 1)
+		{
+			m_Shards[Internal::GetMetricShard()].Value.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] uint64_t GetValue() const;
+
+	private:
+		struct alignas(64) Shard
+		{
+			std::atomic<uint64_t> Value = 0;
+		};
+
+		std::array<Shard, Internal::METRIC_SHARD_COUNT> m_Shards;
+	};
+
+	// Value that goes up and down, e.g. live bytes
+	class MetricGauge
+	{
+	public:
+		void Set(int64_t value) { m_Value.store(value, std::memory_order_relaxed); }
+		void Add(int64_t amount) { m_Value.fetch_add(amount, std::memory_order_relaxed); }
+		void Sub(int64_t amount) { m_Value.fetch_sub(amount, std::memory_order_relaxed); }
+
+		[[nodiscard]] int64_t GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<int64_t> m_Value = 0;
+	};
+
+	struct HistogramSummary
+	{
+		uint64_t Count = 0;
+		double   Sum   = 0.0;
+		double   P50   = 0.0;
+		double   P90   = 0.0;
+		double   P99   = 0.0;
+		uint64_t Max   = 0;
+	};
+
+	// Distribution of unsigned values in log-linear buckets, HDR histogram style: every power of two is split
+	// into SubBuckets linear buckets, so quantiles are accurate to about 1 / SubBuckets of the value.
+	class MetricHistogram
+	{
+	public:
+		static constexpr uint32_t SubBucketBits = 3;
+		static constexpr uint32_t SubBuckets    = 1u << SubBucketBits;
+		static constexpr uint32_t BucketCount   = SubBuckets + (64 - SubBucketBits) * SubBuckets;
+
+		void Record(uint64_t value);
+
+		[[nodiscard]] HistogramSummary Summarize() const;
+
+		[[nodiscard]] static uint32_t GetBucketIndex(uint64_t value);
+		[[nodiscard]] static uint64_t GetBucketLowerBound(uint32_t index);
+		[[nodiscard]] static uint64_t GetBucketUpperBound(uint32_t index);
+
+	private:
+		struct alignas(64) Shard
+		{
+			std::array<std::atomic<uint64_t>, BucketCount> Buckets{};
+			std::atomic<uint64_t>                          Count = 0;
+			std::atomic<uint64_t>                          Sum   = 0;
+		};
+
+		std::array<Shard, Internal::METRIC_SHARD_COUNT> m_Shards;
+		std::atomic<uint64_t>                           m_Max = 0;
+	};
+
+	enum class MetricType : uint8_t
+	{
+		Counter = 0,
+		Gauge,
+		Histogram
+	};
+
+	enum class MetricsFormat : uint8_t
+	{
+		Prometheus = 0,        // Text exposition format, e.g. for the node exporter textfile collector
+		Json
+	};
+
+	struct MetricSnapshot
+	{
+		std::string      Name;
+		std::string      Help;
+		MetricType       Type  = MetricType::Counter;
+		double           Value = 0.0;        // Counters and gauges
+		HistogramSummary Summary;            // Histograms
+	};
+
+	struct MetricsSnapshot
+	{
+		int64_t                     TimestampMs = 0;        // Unix time
+		std::vector<MetricSnapshot> Metrics;
+	};
+
+	struct MetricsSpecification
+	{
+		bool          Publish    = false;
+		std::string   OutputPath = "Metrics/eruption.prom";
+		MetricsFormat Format     = MetricsFormat::Prometheus;
+		uint32_t      IntervalMs = 5000;
+	};
+
+	// Process-wide registry of named metrics. Registration takes a lock and returns a reference that stays
+	// valid for the lifetime of the process, so call sites cache it in a static and update it lock-free:
+	//
+	//     static MetricCounter& s_Submits = Metrics::GetCounter("eruption_vulkan_queue_submits_total", "...");
+	//     s_Submits.Increment();
+	//
+	// Names follow the Prometheus conventions and registering an existing name returns the same metric.
+	class Metrics
+	{
+	public:
+		[[nodiscard]] static MetricCounter&   GetCounter(std::string_view name, std::string_view help = {});
+		[[nodiscard]] static MetricGauge&     GetGauge(std::string_view name, std::string_view help = {});
+		[[nodiscard]] static MetricHistogram& GetHistogram(std::string_view name, std::string_view help = {});
+
+		// Also records how much the counter grew each frame into the histogram <name>_per_frame, with a
+		// trailing _total dropped from the name
+		[[nodiscard]] static MetricCounter& GetPerFrameCounter(std::string_view name, std::string_view help = {});
+
+		// Closes the per-frame counters, called once per frame by the application loop
+		static void MarkFrame();
+
+		[[nodiscard]] static MetricsSnapshot Snapshot();
+
+		[[nodiscard]] static std::string FormatPrometheus(const MetricsSnapshot& snapshot);
+		[[nodiscard]] static std::string FormatJson(const MetricsSnapshot& snapshot);
+
+		// Replaces the file atomically, so scrapers never read a partial snapshot
+		static bool WriteSnapshot(const std::filesystem::path& path, MetricsFormat format);
+
+		// Writes a snapshot every IntervalMs from a background thread until StopPublishing
+		static void StartPublishing(const MetricsSpecification& specification);
+		static void StopPublishing();
+	};
+}        // namespace Eruption
@@ -0,0 +1,339 @@
+#include "Profiler.h"
+
+#include "Eruption/Debug/Telemetry.h"
+
+#include <algorithm>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+namespace Eruption
+{
+	// Zone fields are individually atomic so a capture can read a slot while its owner overwrites it.
+	// Times are raw Clock ticks, converted when captured.
+	struct ProfileZoneSlot
+	{
+		std::atomic<const char*> Name       = nullptr;
+		std::atomic<int64_t>     StartTicks = 0;
+		std::atomic<int64_t>     EndTicks   = 0;
+		std::atomic<uint32_t>    Depth      = 0;
+	};
+
+	// Single producer ring: only the owning thread writes, captures read concurrently
+	struct ProfileTrack
+	{
+		std::array<ProfileZoneSlot, Profiler::ZonesPerThread> Slots;
+		std::atomic<uint64_t>                                 WriteIndex = 0;
+
+		// Guarded by s_TracksMutex
+		uint32_t    ThreadID   = 0;
+		std::string Name;
+		uint64_t    FirstIndex = 0;        // Zones before it belong to the previous owner of a recycled track
+	};
+
+	namespace
+	{
+		// Tracks of exited threads stay registered so their last zones still show up in captures, but only the
+		// most recent ones: short-lived threads would otherwise grow the profiler without bound
+		constexpr size_t RetiredTracksKept = 4;
+
+		std::mutex                                 s_TracksMutex;
+		std::vector<std::shared_ptr<ProfileTrack>> s_Tracks;
+		std::deque<std::shared_ptr<ProfileTrack>>  s_RetiredTracks;        // Oldest first, still in s_Tracks
+		uint32_t                                   s_NextTrackID = 1;
+
+		std::shared_ptr<ProfileTrack> RegisterTrack(std::string_view name)
+		{
+			std::lock_guard lock(s_TracksMutex);
+
+			// Reuses the buffer of an exited thread, the last one to exit stays visible
+			std::shared_ptr<ProfileTrack> track;
+			if (s_RetiredTracks.size() > 1)
+			{
+				track = std::move(s_RetiredTracks.front());
+				s_RetiredTracks.pop_front();
+				track->FirstIndex = track->WriteIndex.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				track = std::make_shared<ProfileTrack>();
+				s_Tracks.push_back(track);
+			}
+
+			track->ThreadID = s_NextTrackID++;
+			track->Name     = name.empty() ? std::format("Thread {0}", track->ThreadID) : std::string(name);
+
+			return track;
+		}
+
+		void RetireTrack(std::shared_ptr<ProfileTrack> track)
+		{
+			std::lock_guard lock(s_TracksMutex);
+
+			s_RetiredTracks.push_back(std::move(track));
+			if (s_RetiredTracks.size() > RetiredTracksKept)
+			{
+				std::erase(s_Tracks, s_RetiredTracks.front());
+				s_RetiredTracks.pop_front();
+			}
+		}
+
+		// Registers the thread's track on first use and retires it when the thread exits
+		struct ThreadTrack
+		{
+			std::shared_ptr<ProfileTrack> Track = RegisterTrack({});
+
+			~ThreadTrack() { RetireTrack(std::move(Track)); }
+		};
+
+		ProfileTrack& GetThreadTrack()
+		{
+			thread_local ThreadTrack track;
+			return *track.Track;
+		}
+
+		void WriteZone(ProfileTrack& track, const char* name, int64_t startTicks, int64_t endTicks, uint32_t depth)
+		{
+			const uint64_t index = track.WriteIndex.load(std::memory_order_relaxed);
+
+			ProfileZoneSlot& slot = track.Slots[index % Profiler::ZonesPerThread];
+			slot.Name.store(name, std::memory_order_relaxed);
+			slot.StartTicks.store(startTicks, std::memory_order_relaxed);
+			slot.EndTicks.store(endTicks, std::memory_order_relaxed);
+			slot.Depth.store(depth, std::memory_order_relaxed);
+
+			track.WriteIndex.store(index + 1, std::memory_order_release);
+
+			if (Telemetry::IsOpen())
+			{
+				Telemetry::PublishZone(
+				    track.ThreadID,
+				    name,
+				    Clock::ToSteadyNanoseconds(startTicks),
+				    Clock::ToSteadyNanoseconds(endTicks),
+				    depth
+				);
+			}
+		}
+
+		void AppendEscaped(std::string& out, std::string_view string)
+		{
+			for (const char c : string)
+			{
+				switch (c)
+				{
+					case '"':  out.append("\\\""); break;
+					case '\\': out.append("\\\\"); break;
+					case '\n': out.append("\\n"); break;
+					case '\t': out.append("\\t"); break;
+					default:
+					{
+						if (static_cast<unsigned char>(c) < 0x20)
+							std::format_to(std::back_inserter(out), "\\u{0:04x}", static_cast<uint32_t>(c));
+						else
+							out.push_back(c);
+						break;
+					}
+				}
+			}
+		}
+	}        // namespace
+
+	void Profiler::SetThreadName(std::string_view name)
+	{
+		ProfileTrack& track = GetThreadTrack();
+
+		std::lock_guard lock(s_TracksMutex);
+		track.Name = name;
+	}
+
+	ProfileTrack* Profiler::CreateTrack(std::string_view name)
+	{
+		return RegisterTrack(name).get();
+	}
+
+	void Profiler::RecordZone(ProfileTrack* track, const ProfileZone& zone)
+	{
+		WriteZone(
+		    *track,
+		    zone.Name,
+		    Clock::FromSteadyNanoseconds(zone.StartNs),
+		    Clock::FromSteadyNanoseconds(zone.EndNs),
+		    zone.Depth
+		);
+	}
+
+	void Profiler::EndZone(const char* name, int64_t startTicks, uint32_t depth)
+	{
+		s_ZoneDepth = depth;
+		WriteZone(GetThreadTrack(), name, startTicks, Clock::GetTicks(), depth);
+	}
+
+	void Profiler::MarkFrame()
+	{
+		const uint64_t frame = s_FrameIndex.load(std::memory_order_relaxed) + 1;
+		s_FrameStartTicks[frame % FrameHistory].store(Clock::GetTicks(), std::memory_order_relaxed);
+		s_FrameIndex.store(frame, std::memory_order_release);
+	}
+
+	ProfileCapture Profiler::Capture(int64_t beginNs, int64_t endNs)
+	{
+		ProfileCapture capture;
+
+		std::vector<std::shared_ptr<ProfileTrack>> tracks;
+		std::vector<uint64_t>                      firstIndices;
+		{
+			std::lock_guard lock(s_TracksMutex);
+			tracks = s_Tracks;
+
+			for (const std::shared_ptr<ProfileTrack>& track : tracks)
+			{
+				capture.Threads.push_back({.ThreadID = track->ThreadID, .Name = track->Name, .Zones = {}});
+				firstIndices.push_back(track->FirstIndex);
+			}
+		}
+
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			const ProfileTrack& buffer = *tracks[i];
+			ProfileThread&      thread = capture.Threads[i];
+
+			const uint64_t writeIndex = buffer.WriteIndex.load(std::memory_order_acquire);
+			const uint64_t oldest     = writeIndex > ZonesPerThread ? writeIndex - ZonesPerThread : 0;
+			const uint64_t first      = std::max(oldest, firstIndices[i]);
+
+			thread.Zones.reserve(writeIndex - first);
+			for (uint64_t index = first; index < writeIndex; ++index)
+			{
+				const ProfileZoneSlot& slot = buffer.Slots[index % ZonesPerThread];
+				thread.Zones.push_back({
+				    .Name    = slot.Name.load(std::memory_order_relaxed),
+				    .StartNs = Clock::ToSteadyNanoseconds(slot.StartTicks.load(std::memory_order_relaxed)),
+				    .EndNs   = Clock::ToSteadyNanoseconds(slot.EndTicks.load(std::memory_order_relaxed)),
+				    .Depth   = slot.Depth.load(std::memory_order_relaxed)
+				});
+			}
+
+			// Seqlock-style validation: drop the slots the owner may have overwritten while we were copying
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const uint64_t latestIndex = buffer.WriteIndex.load(std::memory_order_relaxed);
+			const uint64_t validFirst  = latestIndex >= ZonesPerThread ? latestIndex - ZonesPerThread + 1 : 0;
+			if (validFirst > first)
+			{
+				const size_t overwritten = std::min<uint64_t>(validFirst - first, thread.Zones.size());
+				thread.Zones.erase(thread.Zones.begin(), thread.Zones.begin() + static_cast<ptrdiff_t>(overwritten));
+			}
+
+			std::erase_if(thread.Zones, [beginNs, endNs](const ProfileZone& zone) {
+				return zone.EndNs < beginNs || zone.EndNs > endNs;
+			});
+		}
+
+		const uint64_t frameIndex = s_FrameIndex.load(std::memory_order_acquire);
+		const uint64_t firstFrame = frameIndex >= FrameHistory ? frameIndex - FrameHistory + 1 : 1;
+		for (uint64_t frame = firstFrame; frame <= frameIndex; ++frame)
+		{
+			const int64_t frameStart =
+			    Clock::ToSteadyNanoseconds(s_FrameStartTicks[frame % FrameHistory].load(std::memory_order_relaxed));
+			if (frameStart < beginNs || frameStart > endNs)
+				continue;
+
+			if (capture.FrameStartsNs.empty())
+				capture.FirstFrameIndex = frame;
+			capture.FrameStartsNs.push_back(frameStart);
+		}
+
+		return capture;
+	}
+
+	bool Profiler::WriteChromeTrace(const ProfileCapture& capture, const std::filesystem::path& path)
+	{
+		std::ofstream stream(path);
+		if (!stream)
+			return false;
+
+		// Timestamps are relative to the oldest event so the numbers stay readable in the viewer
+		int64_t origin = INT64_MAX;
+		for (const ProfileThread& thread : capture.Threads)
+		{
+			for (const ProfileZone& zone : thread.Zones)
+				origin = std::min(origin, zone.StartNs);
+		}
+		for (const int64_t frameStart : capture.FrameStartsNs)
+			origin = std::min(origin, frameStart);
+		for (const ProfileCounterSample& sample : capture.Counters)
+			origin = std::min(origin, sample.TimestampNs);
+		if (origin == INT64_MAX)
+			origin = 0;
+
+		const auto toMicroseconds = [origin](int64_t ns) { return static_cast<double>(ns - origin) / 1000.0; };
+
+		std::string out;
+		out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+		bool first = true;
+		const auto beginEvent = [&out, &first] {
+			out.append(first ? "\n" : ",\n");
+			first = false;
+		};
+
+		for (const ProfileThread& thread : capture.Threads)
+		{
+			beginEvent();
+			std::format_to(
+			    std::back_inserter(out),
+			    R"({{"name":"thread_name","ph":"M","pid":1,"tid":{0},"args":{{"name":")",
+			    thread.ThreadID
+			);
+			AppendEscaped(out, thread.Name);
+			out.append("\"}}");
+
+			for (const ProfileZone& zone : thread.Zones)
+			{
+				beginEvent();
+				out.append(R"({"name":")");
+				AppendEscaped(out, zone.Name ? zone.Name : "Unknown");
+				std::format_to(
+				    std::back_inserter(out),
+				    R"(","cat":"cpu","ph":"X","pid":1,"tid":{0},"ts":{1:.3f},"dur":{2:.3f},"args":{{"depth":{3}}}}})",
+				    thread.ThreadID,
+				    toMicroseconds(zone.StartNs),
+				    static_cast<double>(zone.EndNs - zone.StartNs) / 1000.0,
+				    zone.Depth
+				);
+			}
+		}
+
+		for (size_t i = 0; i < capture.FrameStartsNs.size(); ++i)
+		{
+			beginEvent();
+			std::format_to(
+			    std::back_inserter(out),
+			    R"({{"name":"Frame {0}","cat":"frame","ph":"i","s":"g","pid":1,"tid":0,"ts":{1:.3f}}})",
+			    capture.FirstFrameIndex + i,
+			    toMicroseconds(capture.FrameStartsNs[i])
+			);
+		}
+
+		for (const ProfileCounterSample& sample : capture.Counters)
+		{
+			beginEvent();
+			out.append(R"({"name":")");
+			AppendEscaped(out, sample.Name ? sample.Name : "Unknown");
+			std::format_to(
+			    std::back_inserter(out),
+			    R"(","cat":"counter","ph":"C","pid":1,"tid":0,"ts":{0:.3f},"args":{{"value":{1}}}}})",
+			    toMicroseconds(sample.TimestampNs),
+			    sample.Value
+			);
+		}
+
+		out.append("\n]}\n");
+		stream << out;
+
+		return stream.good();
+	}
+}        // namespace Eruption
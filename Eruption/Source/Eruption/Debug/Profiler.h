@@ -0,0 +1,163 @@
+#pragma once
+#include "Eruption/Core/Clock.h"
+#include "Eruption/Debug/MemoryTracker.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if !defined(ER_DIST)
+#	define ER_ENABLE_PROFILING
+#endif
+
+namespace Eruption
+{
+	struct ProfileZone
+	{
+		const char* Name    = nullptr;        // Must outlive the profiler, zone names are string literals
+		int64_t     StartNs = 0;
+		int64_t     EndNs   = 0;
+		uint32_t    Depth   = 0;
+	};
+
+	struct ProfileThread
+	{
+		uint32_t                 ThreadID = 0;
+		std::string              Name;
+		std::vector<ProfileZone> Zones;        // Sorted by end time
+	};
+
+	// Ring buffer of zones shown as one row in trace viewers, owned by the profiler
+	struct ProfileTrack;
+
+	// A value over time, shown as a counter track in trace viewers
+	struct ProfileCounterSample
+	{
+		const char* Name        = nullptr;        // String literal, samples with the same name form one track
+		int64_t     TimestampNs = 0;
+		double      Value       = 0.0;
+	};
+
+	// Snapshot of the profiler buffers, see Profiler::Capture
+	struct ProfileCapture
+	{
+		std::vector<ProfileThread>        Threads;
+		std::vector<int64_t>              FrameStartsNs;
+		uint64_t                          FirstFrameIndex = 0;
+		std::vector<ProfileCounterSample> Counters;        // Not filled by Capture, added by the caller
+	};
+
+	// Always-on hierarchical CPU profiler. Every thread records completed zones into its own fixed-size
+	// ring buffer (track) without locking, so the buffers always hold the most recent few thousand zones per
+	// thread. Zones are recorded in raw Clock ticks; captures copy them out and convert them to nanoseconds
+	// while the engine keeps running.
+	class Profiler
+	{
+	public:
+		static constexpr uint32_t ZonesPerThread = 1u << 14;
+		static constexpr uint32_t FrameHistory   = 256;
+
+		static void SetEnabled(bool enabled) { s_Enabled.store(enabled, std::memory_order_relaxed); }
+		[[nodiscard]] static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+		// Shown as the track name in trace viewers
+		static void SetThreadName(std::string_view name);
+
+		// Tracks not tied to a thread, e.g. GPU queues. A track must only be written by one thread at a time.
+		[[nodiscard]] static ProfileTrack* CreateTrack(std::string_view name);
+		static void                        RecordZone(ProfileTrack* track, const ProfileZone& zone);
+
+		// Nanoseconds on the profiler clock, the steady_clock timeline captures are reported on
+		[[nodiscard]] static int64_t GetTimestamp() { return Clock::ToSteadyNanoseconds(Clock::GetTicks()); }
+
+		// Returns the nesting depth of the new zone
+		[[nodiscard]] static uint32_t BeginZone() { return s_ZoneDepth++; }
+		static void                   EndZone(const char* name, int64_t startTicks, uint32_t depth);
+
+		// Marks the start of a new frame, called once per frame by the application loop
+		static void MarkFrame();
+
+		[[nodiscard]] static uint64_t GetFrameIndex() { return s_FrameIndex.load(std::memory_order_relaxed); }
+
+		// Copies the zones that ended inside [beginNs, endNs] out of every thread buffer, bounds in profiler
+		// clock nanoseconds
+		[[nodiscard]] static ProfileCapture Capture(int64_t beginNs = INT64_MIN, int64_t endNs = INT64_MAX);
+
+		// Writes a capture in the Chrome trace event format, loadable by chrome://tracing and Perfetto
+		static bool WriteChromeTrace(const ProfileCapture& capture, const std::filesystem::path& path);
+		static bool ExportChromeTrace(const std::filesystem::path& path) { return WriteChromeTrace(Capture(), path); }
+
+	private:
+#ifdef ER_ENABLE_PROFILING
+		inline static std::atomic<bool> s_Enabled = true;
+#else
+		inline static std::atomic<bool> s_Enabled = false;
+#endif
+
+		inline static thread_local uint32_t s_ZoneDepth = 0;
+
+		inline static std::atomic<uint64_t>                          s_FrameIndex = 0;
+		inline static std::array<std::atomic<int64_t>, FrameHistory> s_FrameStartTicks{};
+	};
+
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name) :
+		    m_Name(name)
+#ifdef ER_ENABLE_MEMORY_TRACKING
+		    , m_MemoryZone(name)
+#endif
+		{
+			if (!Profiler::IsEnabled())
+				return;
+
+			m_Active = true;
+			m_Depth  = Profiler::BeginZone();
+			m_Start  = Clock::GetTicks();
+		}
+
+		~ProfileScope()
+		{
+			if (m_Active)
+				Profiler::EndZone(m_Name, m_Start, m_Depth);
+		}
+
+		ProfileScope(const ProfileScope&)            = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_Name;
+		int64_t     m_Start  = 0;
+		uint32_t    m_Depth  = 0;
+		bool        m_Active = false;
+
+#ifdef ER_ENABLE_MEMORY_TRACKING
+		// Allocations inside the zone are attributed to it
+		MemoryZoneScope m_MemoryZone;
+#endif
+	};
+}        // namespace Eruption
+
+#ifdef ER_PLATFORM_WINDOWS
+#	define ER_FUNCTION_SIGNATURE __FUNCSIG__
+#else
+#	define ER_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+#endif
+
+#define ER_PROFILE_CONCAT_INTERNAL(a, b) a##b
+#define ER_PROFILE_CONCAT(a, b) ER_PROFILE_CONCAT_INTERNAL(a, b)
+
+#ifdef ER_ENABLE_PROFILING
+#	define ER_PROFILE_SCOPE(name) ::Eruption::ProfileScope ER_PROFILE_CONCAT(erProfileScope, __LINE__)(name)
+#	define ER_PROFILE_FUNCTION() ER_PROFILE_SCOPE(ER_FUNCTION_SIGNATURE)
+#	define ER_PROFILE_FRAME() ::Eruption::Profiler::MarkFrame()
+#else
+#	define ER_PROFILE_SCOPE(name)
+#	define ER_PROFILE_FUNCTION()
+#	define ER_PROFILE_FRAME()
+#endif
@@ -0,0 +1,226 @@
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef ER_PLATFORM_LINUX
+#	include <cerrno>
+#	include <csignal>
+#	include <cstring>
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Eruption
+{
+	namespace
+	{
+		using namespace TelemetryFormat;
+
+		constexpr uint32_t MIN_CAPACITY = 1024;
+
+		// Kept after Close, see Telemetry::Close
+		struct Segment
+		{
+			Header*     SegmentHeader = nullptr;
+			Record*     Records       = nullptr;
+			uint64_t    Mask          = 0;
+			std::string Name;
+		};
+
+		Segment s_Segment;
+
+		template <typename T>
+		void WriteRecord(RecordType type, uint32_t threadID, uint32_t depth, const T& payload)
+		{
+			const uint64_t position = s_Segment.SegmentHeader->WriteIndex.fetch_add(1, std::memory_order_relaxed);
+
+			Record& record = s_Segment.Records[position & s_Segment.Mask];
+			record.Sequence.store(position * 2 + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			record.Info.store(PackInfo(type, threadID, depth), std::memory_order_relaxed);
+			StorePayload(record, payload);
+
+			record.Sequence.store(position * 2 + 2, std::memory_order_release);
+		}
+
+		// Function signatures from ER_PROFILE_FUNCTION are cut down to Class::Function, keeping the end of
+		// names that still do not fit
+		std::array<char, ZoneNameLength> MakeZoneName(std::string_view name)
+		{
+			if (const size_t parameters = name.find('('); parameters != std::string_view::npos && parameters > 0)
+			{
+				name = name.substr(0, parameters);
+				if (const size_t returnType = name.rfind(' '); returnType != std::string_view::npos)
+					name.remove_prefix(returnType + 1);
+			}
+
+			if (name.starts_with("Eruption::"))
+				name.remove_prefix(std::string_view("Eruption::").size());
+
+			if (name.size() >= ZoneNameLength)
+				name.remove_prefix(name.size() - (ZoneNameLength - 1));
+
+			std::array<char, ZoneNameLength> result{};
+			std::ranges::copy(name, result.begin());
+			return result;
+		}
+
+		// Zone names are string literals, so they are shortened once per thread and name
+		const std::array<char, ZoneNameLength>& GetZoneName(const char* name)
+		{
+			thread_local std::unordered_map<const char*, std::array<char, ZoneNameLength>> names;
+
+			auto it = names.find(name);
+			if (it == names.end())
+				it = names.emplace(name, MakeZoneName(name)).first;
+
+			return it->second;
+		}
+
+#ifdef ER_PLATFORM_LINUX
+		// The process still publishing to an existing segment, 0 when there is none or its writer has exited
+		uint32_t FindLiveWriter(const char* name)
+		{
+			const int file = shm_open(name, O_RDONLY, 0);
+			if (file < 0)
+				return 0;
+
+			struct stat status{};
+			void*       mapping = MAP_FAILED;
+			if (fstat(file, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(Header))
+				mapping = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, file, 0);
+
+			close(file);
+
+			if (mapping == MAP_FAILED)
+				return 0;
+
+			const auto*    header    = static_cast<const Header*>(mapping);
+			const uint32_t processID = header->FileMagic == Magic ? header->ProcessID : 0;
+			munmap(mapping, sizeof(Header));
+
+			if (processID == 0 || (kill(static_cast<pid_t>(processID), 0) != 0 && errno != EPERM))
+				return 0;
+
+			return processID;
+		}
+#endif
+	}        // namespace
+
+	bool Telemetry::Open(const TelemetrySpecification& specification)
+	{
+#ifdef ER_PLATFORM_LINUX
+		if (IsOpen())
+		{
+			ER_CORE_WARN_TAG("Telemetry", "Already publishing to {0}", s_Segment.Name);
+			return true;
+		}
+
+		const uint32_t capacity = std::bit_ceil(std::max(specification.Capacity, MIN_CAPACITY));
+		const uint64_t size     = GetSegmentSize(capacity);
+		const char*    name     = specification.Name.c_str();
+
+		// Another engine on the host publishing under the same name keeps it, a crashed run leaves its segment
+		// behind
+		if (const uint32_t writer = FindLiveWriter(name); writer != 0)
+		{
+			ER_CORE_ERROR_TAG(
+			    "Telemetry", "Shared memory {0} is in use by process {1}, pick another name", name, writer
+			);
+			return false;
+		}
+
+		shm_unlink(name);
+
+		const int file = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (file < 0)
+		{
+			ER_CORE_ERROR_TAG("Telemetry", "Failed to create shared memory {0}: {1}", name, std::strerror(errno));
+			return false;
+		}
+
+		void* mapping = MAP_FAILED;
+		if (ftruncate(file, static_cast<off_t>(size)) == 0)
+			mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+		close(file);
+
+		if (mapping == MAP_FAILED)
+		{
+			ER_CORE_ERROR_TAG("Telemetry", "Failed to map shared memory {0}: {1}", name, std::strerror(errno));
+			shm_unlink(name);
+			return false;
+		}
+
+		auto* header  = new (mapping) Header;
+		auto* records = reinterpret_cast<Record*>(header + 1);
+		std::uninitialized_default_construct_n(records, capacity);
+
+		// The magic goes in last, a viewer ignores the segment until the rest of the header is valid
+		header->FileMagic     = {};
+		header->Capacity      = capacity;
+		header->ProcessID     = static_cast<uint32_t>(getpid());
+		header->WallClockNs   = std::chrono::system_clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+		header->SteadyClockNs = std::chrono::steady_clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+		std::atomic_thread_fence(std::memory_order_release);
+		header->FileMagic = Magic;
+
+		s_Segment = {.SegmentHeader = header, .Records = records, .Mask = capacity - 1, .Name = specification.Name};
+		s_Open.store(true, std::memory_order_release);
+
+		ER_CORE_INFO_TAG(
+		    "Telemetry", "Publishing to shared memory {0} ({1} records, {2} KiB)", name, capacity, size / 1024
+		);
+		return true;
+#else
+		ER_CORE_WARN_TAG("Telemetry", "Live telemetry needs POSIX shared memory, not available on this platform");
+		return false;
+#endif
+	}
+
+	void Telemetry::Close()
+	{
+		if (!s_Open.exchange(false, std::memory_order_acq_rel))
+			return;
+
+#ifdef ER_PLATFORM_LINUX
+		// The mapping itself stays, a thread that saw the channel open may still be writing a record. A viewer
+		// keeps its own mapping and notices the engine is gone through the process ID.
+		shm_unlink(s_Segment.Name.c_str());
+#endif
+	}
+
+	void Telemetry::PublishZone(uint32_t threadID, const char* name, int64_t startNs, int64_t endNs, uint32_t depth)
+	{
+		if (!s_Open.load(std::memory_order_acquire))
+			return;
+
+		WriteRecord(
+		    RecordType::Zone,
+		    threadID,
+		    depth,
+		    ZoneRecord{.StartNs = startNs, .DurationNs = endNs - startNs, .Name = GetZoneName(name)}
+		);
+	}
+
+	void Telemetry::PublishFrame(const FrameRecord& frame)
+	{
+		if (s_Open.load(std::memory_order_acquire))
+			WriteRecord(RecordType::Frame, 0, 0, frame);
+	}
+
+	void Telemetry::PublishMemoryBudget(const MemoryBudgetRecord& budget)
+	{
+		if (s_Open.load(std::memory_order_acquire))
+			WriteRecord(RecordType::MemoryBudget, 0, 0, budget);
+	}
+}        // namespace Eruption
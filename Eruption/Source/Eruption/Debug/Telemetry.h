@@ -0,0 +1,36 @@
+#pragma once
+#include "Eruption/Debug/TelemetryFormat.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Eruption
+{
+	struct TelemetrySpecification
+	{
+		bool        Enabled  = false;
+		std::string Name     = TelemetryFormat::DefaultName;        // POSIX shared memory object, one engine per name
+		uint32_t    Capacity = 1u << 16;                           // Records, rounded up to a power of two
+	};
+
+	// Publishes profiler zones, frame statistics and memory budgets into a shared memory ring that the
+	// Eruption-TelemetryViewer tool reads live, see TelemetryFormat.h for the layout. Publishing never blocks:
+	// a viewer that falls behind loses the oldest records. Only implemented on POSIX platforms.
+	class Telemetry
+	{
+	public:
+		static bool Open(const TelemetrySpecification& specification);
+		static void Close();
+
+		[[nodiscard]] static bool IsOpen() { return s_Open.load(std::memory_order_relaxed); }
+
+		// Times in steady_clock nanoseconds, called by the profiler for every completed zone while open
+		static void PublishZone(uint32_t threadID, const char* name, int64_t startNs, int64_t endNs, uint32_t depth);
+		static void PublishFrame(const TelemetryFormat::FrameRecord& frame);
+		static void PublishMemoryBudget(const TelemetryFormat::MemoryBudgetRecord& budget);
+
+	private:
+		inline static std::atomic<bool> s_Open = false;
+	};
+}        // namespace Eruption
@@ -0,0 +1,126 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Layout of the live telemetry shared memory segment. Shared by the engine writer and the standalone viewer,
+// so this header must not depend on anything else in the engine.
+//
+// Segment := Header Record[Capacity]
+//
+// The records form a ring that the engine never waits on: writers claim a position with a fetch_add on
+// WriteIndex and overwrite whatever the slot held, so a reader that falls behind loses records instead of
+// stalling the engine. Every slot is a sequence lock: Sequence is 2 * position + 1 while the slot is written
+// and 2 * position + 2 once it is complete. A reader copies the slot and accepts it only if Sequence read
+// 2 * position + 2 both before and after the copy.
+//
+// All fields a reader may see change are atomics, so reading a slot while it is overwritten is only a
+// rejected record, never undefined behaviour.
+namespace Eruption::TelemetryFormat
+{
+	inline constexpr std::array<char, 8> Magic       = {'E', 'R', 'T', 'E', 'L', 'E', 'M', '\0'};
+	inline constexpr uint32_t            Version     = 1;
+	inline constexpr const char*         DefaultName = "/eruption-telemetry";
+
+	inline constexpr uint32_t PayloadWords   = 6;
+	inline constexpr uint32_t ZoneNameLength = 32;        // Including the terminator, longer names are cut
+
+	enum class RecordType : uint8_t
+	{
+		Zone         = 1,
+		Frame        = 2,
+		MemoryBudget = 3
+	};
+
+	// Payloads, copied in and out of the slot words
+	struct ZoneRecord
+	{
+		int64_t                          StartNs    = 0;        // steady_clock nanoseconds
+		int64_t                          DurationNs = 0;
+		std::array<char, ZoneNameLength> Name{};
+	};
+
+	struct FrameRecord
+	{
+		uint64_t FrameIndex      = 0;
+		int64_t  FrameTimeNs     = 0;
+		int64_t  CpuTimeNs       = 0;
+		int64_t  HeapLiveBytes   = 0;        // Zero unless the engine was built with memory tracking
+		uint64_t HeapAllocations = 0;        // During the frame, zero unless built with memory tracking
+		int64_t  GpuLiveBytes    = 0;
+	};
+
+	struct MemoryBudgetRecord
+	{
+		uint32_t HeapIndex       = 0;
+		uint32_t HeapCount       = 0;
+		uint64_t BlockBytes      = 0;
+		uint64_t AllocationBytes = 0;
+		uint64_t Usage           = 0;        // By the whole process, as reported by the driver
+		uint64_t Budget          = 0;
+	};
+
+	struct alignas(64) Record
+	{
+		std::atomic<uint64_t>                           Sequence = 0;
+		std::atomic<uint64_t>                           Info     = 0;        // See PackInfo
+		std::array<std::atomic<uint64_t>, PayloadWords> Payload{};
+	};
+
+	struct alignas(64) Header
+	{
+		std::array<char, 8> FileMagic     = Magic;
+		uint32_t            FileVersion   = Version;
+		uint32_t            Capacity      = 0;        // Records, a power of two
+		uint32_t            RecordSize    = sizeof(Record);
+		uint32_t            ProcessID     = 0;
+		int64_t             WallClockNs   = 0;        // system_clock time matching SteadyClockNs
+		int64_t             SteadyClockNs = 0;
+
+		// On its own cache line, every writer touches it
+		alignas(64) std::atomic<uint64_t> WriteIndex = 0;
+	};
+
+	static_assert(sizeof(Record) == 64);
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory atomics must be lock-free");
+	static_assert(sizeof(ZoneRecord) <= sizeof(uint64_t) * PayloadWords);
+	static_assert(sizeof(FrameRecord) <= sizeof(uint64_t) * PayloadWords);
+	static_assert(sizeof(MemoryBudgetRecord) <= sizeof(uint64_t) * PayloadWords);
+
+	[[nodiscard]] constexpr uint64_t GetSegmentSize(uint32_t capacity)
+	{
+		return sizeof(Header) + static_cast<uint64_t>(capacity) * sizeof(Record);
+	}
+
+	[[nodiscard]] constexpr uint64_t PackInfo(RecordType type, uint32_t threadID, uint32_t depth)
+	{
+		return static_cast<uint64_t>(type) | (static_cast<uint64_t>(depth & 0xFFFFFF) << 8) |
+		       (static_cast<uint64_t>(threadID) << 32);
+	}
+
+	[[nodiscard]] constexpr RecordType GetType(uint64_t info) { return static_cast<RecordType>(info & 0xFF); }
+	[[nodiscard]] constexpr uint32_t   GetDepth(uint64_t info) { return static_cast<uint32_t>(info >> 8) & 0xFFFFFF; }
+	[[nodiscard]] constexpr uint32_t   GetThreadID(uint64_t info) { return static_cast<uint32_t>(info >> 32); }
+
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	void StorePayload(Record& record, const T& payload)
+	{
+		std::array<uint64_t, PayloadWords> words{};
+		std::memcpy(words.data(), &payload, sizeof(T));
+
+		for (uint32_t i = 0; i < PayloadWords; ++i)
+			record.Payload[i].store(words[i], std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	[[nodiscard]] T LoadPayload(const std::array<uint64_t, PayloadWords>& words)
+	{
+		T payload;
+		std::memcpy(static_cast<void*>(&payload), words.data(), sizeof(T));
+		return payload;
+	}
+}        // namespace Eruption::TelemetryFormat
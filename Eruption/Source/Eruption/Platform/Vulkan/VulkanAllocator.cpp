@@ -1,5 +1,10 @@
 #include "VulkanAllocator.h"
 
+#include "Eruption/Debug/Metrics.h"
+
+#include <fstream>
+#include <map>
+
 namespace Eruption
 {
 	namespace Utils
@@ -20,6 +25,35 @@ namespace Eruption
 				ER_CORE_TRACE_TAG("VulkanAllocator", "Freed {} bytes of memory type {}", size, memoryType);
 			}
 
+			MetricGauge& GetLiveBytesGauge()
+			{
+				static MetricGauge& s_Gauge =
+				    Metrics::GetGauge("eruption_gpu_memory_live_bytes", "Bytes in live VMA allocations");
+				return s_Gauge;
+			}
+
+			MetricGauge& GetLiveAllocationsGauge()
+			{
+				static MetricGauge& s_Gauge =
+				    Metrics::GetGauge("eruption_gpu_memory_live_allocations", "Number of live VMA allocations");
+				return s_Gauge;
+			}
+
+			void RecordAllocationCreated(const VmaAllocationInfo& info)
+			{
+				GetLiveBytesGauge().Add(static_cast<int64_t>(info.size));
+				GetLiveAllocationsGauge().Add(1);
+			}
+
+			void RecordAllocationDestroyed(VmaAllocator allocator, VmaAllocation allocation)
+			{
+				VmaAllocationInfo info;
+				vmaGetAllocationInfo(allocator, allocation, &info);
+
+				GetLiveBytesGauge().Sub(static_cast<int64_t>(info.size));
+				GetLiveAllocationsGauge().Sub(1);
+			}
+
 			std::string FormatBytes(uint64_t bytes)
 			{
 				constexpr uint64_t KiB = 1024;
@@ -35,6 +69,54 @@ namespace Eruption
 				return std::format("{} B", bytes);
 			}
 
+			void AppendJsonEscaped(std::string& out, std::string_view string)
+			{
+				for (const char c : string)
+				{
+					switch (c)
+					{
+						case '\\': out.append("\\\\"); break;
+						case '"':  out.append("\\\""); break;
+						default:
+						{
+							if (static_cast<unsigned char>(c) < 0x20)
+								std::format_to(std::back_inserter(out), "\\u{0:04x}", static_cast<uint32_t>(c));
+							else
+								out.push_back(c);
+							break;
+						}
+					}
+				}
+			}
+
+			bool HasFlag(AllocationCreateFlags flags, AllocationCreateFlagBits bit)
+			{
+				return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(bit)) != 0;
+			}
+
+			// Host-visible allocations are created persistently mapped, so using them never maps memory. VMA ignores
+			// the flag when the memory type it picks turns out not to be host visible.
+			AllocationCreateFlags AddPersistentMapping(MemoryUsage usage, AllocationCreateFlags flags)
+			{
+				const bool hostUsage = usage == MemoryUsage::CpuOnly || usage == MemoryUsage::CpuToGpu ||
+				                       usage == MemoryUsage::GpuToCpu || usage == MemoryUsage::CpuCopy;
+				const bool hostAccess = HasFlag(flags, AllocationCreateFlagBits::HostAccessSequentialWrite) ||
+				                        HasFlag(flags, AllocationCreateFlagBits::HostAccessRandom);
+
+				if (hostUsage || hostAccess)
+					flags |= AllocationCreateFlagBits::Mapped;
+
+				return flags;
+			}
+
+			// Callers asking to stay within the budget expect to be refused and evict or fall back, which is not
+			// worth an error
+			bool IsBudgetRefusal(const VmaAllocationCreateInfo& allocInfo, vk::Result result)
+			{
+				return result == vk::Result::eErrorOutOfDeviceMemory &&
+				       (allocInfo.flags & VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT) != 0;
+			}
+
 			VmaMemoryUsage ConvertMemoryUsage(MemoryUsage usage)
 			{
 				switch (usage)
@@ -91,6 +173,104 @@ namespace Eruption
 		}        // namespace
 	}        // namespace Utils
 
+	/* ------------------------------------------------------------------------------------------------------- */
+	/* --------------------------------------- VulkanAllocationTracker --------------------------------------- */
+	/* ------------------------------------------------------------------------------------------------------- */
+	void VulkanAllocationTracker::Track(
+	    VmaAllocation allocation, vk::DeviceSize size, const char* kind, std::source_location location
+	)
+	{
+		if constexpr (!IsEnabled())
+			return;
+
+		Shard&          shard = m_Shards[GetShardIndex(allocation)];
+		std::lock_guard lock(shard.Mutex);
+		shard.Entries.insert_or_assign(allocation, Entry{.Size = size, .Kind = kind, .Location = location});
+	}
+
+	void VulkanAllocationTracker::Untrack(VmaAllocation allocation)
+	{
+		if constexpr (!IsEnabled())
+			return;
+
+		Shard&          shard = m_Shards[GetShardIndex(allocation)];
+		std::lock_guard lock(shard.Mutex);
+		shard.Entries.erase(allocation);
+	}
+
+	void VulkanAllocationTracker::SetName(VmaAllocator allocator, VmaAllocation allocation, const char* name)
+	{
+		if constexpr (!IsEnabled())
+		{
+			vmaSetAllocationName(allocator, allocation, name);
+			return;
+		}
+
+		Shard&          shard = m_Shards[GetShardIndex(allocation)];
+		std::lock_guard lock(shard.Mutex);
+		vmaSetAllocationName(allocator, allocation, name);
+	}
+
+	size_t VulkanAllocationTracker::GetCount() const
+	{
+		size_t count = 0;
+		for (const Shard& shard : m_Shards)
+		{
+			std::lock_guard lock(shard.Mutex);
+			count += shard.Entries.size();
+		}
+
+		return count;
+	}
+
+	std::vector<AllocationSiteStats> VulkanAllocationTracker::GetSiteStats(VmaAllocator allocator) const
+	{
+		// File names from source_location are string literals, so they can be part of the key as views
+		using SiteKey = std::tuple<std::string, std::string_view, uint32_t>;
+		std::map<SiteKey, AllocationSiteStats> sites;
+
+		for (const Shard& shard : m_Shards)
+		{
+			std::lock_guard lock(shard.Mutex);
+			for (const auto& [allocation, entry] : shard.Entries)
+			{
+				// Read under the shard lock, the allocation cannot be freed before it is untracked
+				VmaAllocationInfo info;
+				vmaGetAllocationInfo(allocator, allocation, &info);
+
+				std::string tag = info.pName ? info.pName : entry.Kind;
+				SiteKey     key{std::move(tag), entry.Location.file_name(), entry.Location.line()};
+
+				AllocationSiteStats& site = sites[key];
+				if (site.Count == 0)
+				{
+					site.Tag      = std::get<0>(key);
+					site.File     = entry.Location.file_name();
+					site.Function = entry.Location.function_name();
+					site.Line     = entry.Location.line();
+				}
+
+				site.Count++;
+				site.Bytes += entry.Size;
+			}
+		}
+
+		std::vector<AllocationSiteStats> result;
+		result.reserve(sites.size());
+		for (AllocationSiteStats& site : sites | std::views::values)
+			result.push_back(std::move(site));
+
+		std::ranges::sort(result, std::ranges::greater{}, &AllocationSiteStats::Bytes);
+		return result;
+	}
+
+	uint32_t VulkanAllocationTracker::GetShardIndex(VmaAllocation allocation)
+	{
+		// Handles come from VMA's pool allocator and share their low bits, Fibonacci hashing mixes in the rest
+		const auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(allocation)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<uint32_t>((hash >> 32) % SHARD_COUNT);
+	}
+
 	/* ------------------------------------------------------------------------------------------------------- */
 	/* ----------------------------------------- VulkanAllocator --------------------------------------------- */
 	/* ------------------------------------------------------------------------------------------------------- */
@@ -141,27 +321,34 @@ namespace Eruption
 
 	void VulkanAllocator::Destroy()
 	{
-#ifdef ER_DEBUG
 		// Check for leaked allocations
+		if (const size_t leaked = m_Tracker.GetCount(); leaked > 0)
 		{
-			std::lock_guard lock(m_TrackerMutex);
-			if (!m_AllocationTracker.empty())
+			ER_CORE_ERROR_TAG("VulkanAllocator", "Leaked {} allocations:", leaked);
+			for (const AllocationSiteStats& site : GetAllocationSites())
 			{
-				ER_CORE_ERROR_TAG("VulkanAllocator", "Leaked {} allocations:", m_AllocationTracker.size());
-				for (const auto& [deviceSize, name, location] : m_AllocationTracker | std::ranges::views::values)
-				{
-					ER_CORE_ERROR_TAG(
-					    "VulkanAllocator",
-					    "\t- {} ({}) at {}:{}",
-					    name,
-					    Utils::FormatBytes(deviceSize),
-					    location.file_name(),
-					    location.line()
-					);
-				}
+				ER_CORE_ERROR_TAG(
+				    "VulkanAllocator",
+				    "\t- {} x{} ({}) at {}:{} in {}",
+				    site.Tag,
+				    site.Count,
+				    Utils::FormatBytes(site.Bytes),
+				    site.File,
+				    site.Line,
+				    site.Function
+				);
 			}
 		}
-#endif
+
+		{
+			std::lock_guard lock(m_PoolMutex);
+			for (const auto& [pool, name] : m_Pools)
+			{
+				ER_CORE_ERROR_TAG("VulkanAllocator", "Pool '{}' was not destroyed", name);
+				vmaDestroyPool(m_Allocator, pool);
+			}
+			m_Pools.clear();
+		}
 
 		if (m_Allocator)
 		{
@@ -171,93 +358,300 @@ namespace Eruption
 	}
 
 	std::expected<VmaAllocation, vk::Result> VulkanAllocator::AllocateBuffer(
-	    const vk::BufferCreateInfo& createInfo, MemoryUsage usage, vk::Buffer& outBuffer, AllocationCreateFlags flags
+	    const vk::BufferCreateInfo& createInfo,
+	    MemoryUsage                 usage,
+	    vk::Buffer&                 outBuffer,
+	    AllocationCreateFlags       flags,
+	    std::source_location        location
+	)
+	{
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.usage = Utils::ConvertMemoryUsage(usage);
+		allocInfo.flags = Utils::ConvertAllocationFlags(Utils::AddPersistentMapping(usage, flags));
+
+		return CreateBuffer(createInfo, allocInfo, outBuffer, location);
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanAllocator::AllocateBuffer(
+	    const vk::BufferCreateInfo& createInfo,
+	    VmaPool                     pool,
+	    vk::Buffer&                 outBuffer,
+	    AllocationCreateFlags       flags,
+	    std::source_location        location
+	)
+	{
+		ER_CORE_ASSERT(pool);
+
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.pool  = pool;
+		allocInfo.flags = Utils::ConvertAllocationFlags(Utils::AddPersistentMapping(MemoryUsage::Auto, flags));
+
+		return CreateBuffer(createInfo, allocInfo, outBuffer, location);
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanAllocator::AllocateImage(
+	    const vk::ImageCreateInfo& createInfo,
+	    MemoryUsage                usage,
+	    vk::Image&                 outImage,
+	    AllocationCreateFlags      flags,
+	    std::source_location       location
 	)
 	{
 		VmaAllocationCreateInfo allocInfo{};
 		allocInfo.usage = Utils::ConvertMemoryUsage(usage);
-		allocInfo.flags = Utils::ConvertAllocationFlags(flags);
+		allocInfo.flags = Utils::ConvertAllocationFlags(Utils::AddPersistentMapping(usage, flags));
+
+		return CreateImage(createInfo, allocInfo, outImage, location);
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanAllocator::AllocateImage(
+	    const vk::ImageCreateInfo& createInfo,
+	    VmaPool                    pool,
+	    vk::Image&                 outImage,
+	    AllocationCreateFlags      flags,
+	    std::source_location       location
+	)
+	{
+		ER_CORE_ASSERT(pool);
+
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.pool  = pool;
+		allocInfo.flags = Utils::ConvertAllocationFlags(Utils::AddPersistentMapping(MemoryUsage::Auto, flags));
+
+		return CreateImage(createInfo, allocInfo, outImage, location);
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanAllocator::AllocateMemory(
+	    const vk::MemoryRequirements& requirements,
+	    vk::MemoryPropertyFlags       requiredFlags,
+	    AllocationCreateFlags         flags,
+	    std::source_location          location
+	)
+	{
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.usage         = VMA_MEMORY_USAGE_UNKNOWN;
+		allocInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(requiredFlags);
+		allocInfo.flags         = Utils::ConvertAllocationFlags(flags);
 
-		auto          vkCreateInfo = static_cast<VkBufferCreateInfo>(createInfo);
-		VkBuffer      vkBuffer;
-		VmaAllocation allocation;
+		const auto        vkRequirements = static_cast<VkMemoryRequirements>(requirements);
+		VmaAllocation     allocation;
+		VmaAllocationInfo allocationInfo;
 
 		const auto result = static_cast<vk::Result>(
-		    vmaCreateBuffer(m_Allocator, &vkCreateInfo, &allocInfo, &vkBuffer, &allocation, nullptr)
+		    vmaAllocateMemory(m_Allocator, &vkRequirements, &allocInfo, &allocation, &allocationInfo)
 		);
 
 		if (result != vk::Result::eSuccess)
 		{
-			ER_CORE_ERROR_TAG(
-			    "VulkanAllocator",
-			    "Failed to allocate buffer of size {}: {}",
-			    Utils::FormatBytes(createInfo.size),
-			    vk::to_string(result)
-			);
+			if (!Utils::IsBudgetRefusal(allocInfo, result))
+				ER_CORE_ERROR_TAG(
+				    "VulkanAllocator",
+				    "Failed to allocate {} of memory: {}",
+				    Utils::FormatBytes(requirements.size),
+				    vk::to_string(result)
+				);
+
+			return std::unexpected(result);
+		}
+
+		Utils::RecordAllocationCreated(allocationInfo);
+		m_Tracker.Track(allocation, allocationInfo.size, "Memory", location);
+
+		return allocation;
+	}
+
+	void VulkanAllocator::BindBufferMemory(VmaAllocation allocation, vk::DeviceSize offset, vk::Buffer buffer) const
+	{
+		VK_CHECK_RESULT(vmaBindBufferMemory2(m_Allocator, allocation, offset, buffer, nullptr));
+	}
+
+	void VulkanAllocator::BindImageMemory(VmaAllocation allocation, vk::DeviceSize offset, vk::Image image) const
+	{
+		VK_CHECK_RESULT(vmaBindImageMemory2(m_Allocator, allocation, offset, image, nullptr));
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanAllocator::CreateBuffer(
+	    const vk::BufferCreateInfo&    createInfo,
+	    const VmaAllocationCreateInfo& allocInfo,
+	    vk::Buffer&                    outBuffer,
+	    std::source_location           location
+	)
+	{
+		auto              vkCreateInfo = static_cast<VkBufferCreateInfo>(createInfo);
+		VkBuffer          vkBuffer;
+		VmaAllocation     allocation;
+		VmaAllocationInfo allocationInfo;
+
+		const auto result = static_cast<vk::Result>(
+		    vmaCreateBuffer(m_Allocator, &vkCreateInfo, &allocInfo, &vkBuffer, &allocation, &allocationInfo)
+		);
+
+		if (result != vk::Result::eSuccess)
+		{
+			if (!Utils::IsBudgetRefusal(allocInfo, result))
+				ER_CORE_ERROR_TAG(
+				    "VulkanAllocator",
+				    "Failed to allocate buffer of size {}: {}",
+				    Utils::FormatBytes(createInfo.size),
+				    vk::to_string(result)
+				);
 
 			return std::unexpected(result);
 		}
 
 		outBuffer = vkBuffer;
 
-#ifdef ER_DEBUG
+		Utils::RecordAllocationCreated(allocationInfo);
+		m_Tracker.Track(allocation, allocationInfo.size, "Buffer", location);
+
+		return allocation;
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanAllocator::CreateImage(
+	    const vk::ImageCreateInfo&     createInfo,
+	    const VmaAllocationCreateInfo& allocInfo,
+	    vk::Image&                     outImage,
+	    std::source_location           location
+	)
+	{
+		auto              vkCreateInfo = static_cast<VkImageCreateInfo>(createInfo);
+		VkImage           vkImage;
+		VmaAllocation     allocation;
+		VmaAllocationInfo allocationInfo;
+
+		const auto result = static_cast<vk::Result>(
+		    vmaCreateImage(m_Allocator, &vkCreateInfo, &allocInfo, &vkImage, &allocation, &allocationInfo)
+		);
+
+		if (result != vk::Result::eSuccess)
 		{
-			std::lock_guard   lock(m_TrackerMutex);
-			VmaAllocationInfo info;
-			vmaGetAllocationInfo(m_Allocator, allocation, &info);
-			m_AllocationTracker[allocation] = {
-			    .Size = info.size, .Name = "Buffer", .Location = std::source_location::current()
-			};
+			if (!Utils::IsBudgetRefusal(allocInfo, result))
+				ER_CORE_ERROR_TAG(
+				    "VulkanAllocator",
+				    "Failed to allocate image {}x{}x{}: {}",
+				    createInfo.extent.width,
+				    createInfo.extent.height,
+				    createInfo.extent.depth,
+				    vk::to_string(result)
+				);
+
+			return std::unexpected(result);
 		}
-#endif
+
+		outImage = vkImage;
+
+		Utils::RecordAllocationCreated(allocationInfo);
+		m_Tracker.Track(allocation, allocationInfo.size, "Image", location);
 
 		return allocation;
 	}
 
-	std::expected<VmaAllocation, vk::Result> VulkanAllocator::AllocateImage(
-	    const vk::ImageCreateInfo& createInfo, MemoryUsage usage, vk::Image& outImage, AllocationCreateFlags flags
+	std::expected<VmaPool, vk::Result> VulkanAllocator::CreatePool(
+	    const MemoryPoolSpecification& specification, const vk::BufferCreateInfo& exampleCreateInfo
 	)
 	{
 		VmaAllocationCreateInfo allocInfo{};
-		allocInfo.usage = Utils::ConvertMemoryUsage(usage);
-		allocInfo.flags = Utils::ConvertAllocationFlags(flags);
+		allocInfo.usage = Utils::ConvertMemoryUsage(specification.Usage);
+		allocInfo.flags = Utils::ConvertAllocationFlags(specification.Flags);
 
-		auto          vkCreateInfo = static_cast<VkImageCreateInfo>(createInfo);
-		VkImage       vkImage;
-		VmaAllocation allocation;
+		const auto vkCreateInfo    = static_cast<VkBufferCreateInfo>(exampleCreateInfo);
+		uint32_t   memoryTypeIndex = 0;
 
 		const auto result = static_cast<vk::Result>(
-		    vmaCreateImage(m_Allocator, &vkCreateInfo, &allocInfo, &vkImage, &allocation, nullptr)
+		    vmaFindMemoryTypeIndexForBufferInfo(m_Allocator, &vkCreateInfo, &allocInfo, &memoryTypeIndex)
 		);
 
 		if (result != vk::Result::eSuccess)
 		{
 			ER_CORE_ERROR_TAG(
-			    "VulkanAllocator",
-			    "Failed to allocate image {}x{}x{}: {}",
-			    createInfo.extent.width,
-			    createInfo.extent.height,
-			    createInfo.extent.depth,
-			    vk::to_string(result)
+			    "VulkanAllocator", "No memory type for pool '{}': {}", specification.Name, vk::to_string(result)
 			);
+			return std::unexpected(result);
+		}
+
+		return CreatePool(specification, memoryTypeIndex);
+	}
+
+	std::expected<VmaPool, vk::Result> VulkanAllocator::CreatePool(
+	    const MemoryPoolSpecification& specification, const vk::ImageCreateInfo& exampleCreateInfo
+	)
+	{
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.usage = Utils::ConvertMemoryUsage(specification.Usage);
+		allocInfo.flags = Utils::ConvertAllocationFlags(specification.Flags);
+
+		const auto vkCreateInfo    = static_cast<VkImageCreateInfo>(exampleCreateInfo);
+		uint32_t   memoryTypeIndex = 0;
+
+		const auto result = static_cast<vk::Result>(
+		    vmaFindMemoryTypeIndexForImageInfo(m_Allocator, &vkCreateInfo, &allocInfo, &memoryTypeIndex)
+		);
 
+		if (result != vk::Result::eSuccess)
+		{
+			ER_CORE_ERROR_TAG(
+			    "VulkanAllocator", "No memory type for pool '{}': {}", specification.Name, vk::to_string(result)
+			);
 			return std::unexpected(result);
 		}
 
-		outImage = vkImage;
+		return CreatePool(specification, memoryTypeIndex);
+	}
 
-#ifdef ER_DEBUG
+	std::expected<VmaPool, vk::Result> VulkanAllocator::CreatePool(
+	    const MemoryPoolSpecification& specification, uint32_t memoryTypeIndex
+	)
+	{
+		VmaPoolCreateInfo poolInfo{};
+		poolInfo.memoryTypeIndex = memoryTypeIndex;
+		poolInfo.blockSize       = specification.BlockSize;
+		poolInfo.minBlockCount   = specification.MinBlockCount;
+		poolInfo.maxBlockCount   = specification.MaxBlockCount;
+
+		if (specification.Algorithm == MemoryPoolAlgorithm::Linear)
+			poolInfo.flags |= VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT;
+
+		VmaPool    pool   = VK_NULL_HANDLE;
+		const auto result = static_cast<vk::Result>(vmaCreatePool(m_Allocator, &poolInfo, &pool));
+
+		if (result != vk::Result::eSuccess)
 		{
-			std::lock_guard   lock(m_TrackerMutex);
-			VmaAllocationInfo info;
-			vmaGetAllocationInfo(m_Allocator, allocation, &info);
-			m_AllocationTracker[allocation] = {
-			    .Size = info.size, .Name = "Image", .Location = std::source_location::current()
-			};
+			ER_CORE_ERROR_TAG(
+			    "VulkanAllocator", "Failed to create pool '{}': {}", specification.Name, vk::to_string(result)
+			);
+			return std::unexpected(result);
 		}
-#endif
 
-		return allocation;
+		vmaSetPoolName(m_Allocator, pool, specification.Name.c_str());
+
+		{
+			std::lock_guard lock(m_PoolMutex);
+			m_Pools.emplace(pool, specification.Name);
+		}
+
+		ER_CORE_INFO_TAG(
+		    "VulkanAllocator",
+		    "Created pool '{}' on memory type {} (block size {}, {}-{} blocks)",
+		    specification.Name,
+		    memoryTypeIndex,
+		    specification.BlockSize ? Utils::FormatBytes(specification.BlockSize) : "default",
+		    specification.MinBlockCount,
+		    specification.MaxBlockCount ? std::to_string(specification.MaxBlockCount) : "unlimited"
+		);
+
+		return pool;
+	}
+
+	void VulkanAllocator::DestroyPool(VmaPool pool)
+	{
+		ER_CORE_ASSERT(pool);
+
+		{
+			std::lock_guard lock(m_PoolMutex);
+			m_Pools.erase(pool);
+		}
+
+		vmaDestroyPool(m_Allocator, pool);
 	}
 
 	void VulkanAllocator::UnmapMemory(VmaAllocation allocation) const
@@ -270,13 +664,8 @@ namespace Eruption
 		ER_CORE_ASSERT(buffer);
 		ER_CORE_ASSERT(allocation);
 
-#ifdef ER_DEBUG
-		{
-			std::lock_guard lock(m_TrackerMutex);
-			m_AllocationTracker.erase(allocation);
-		}
-#endif
-
+		m_Tracker.Untrack(allocation);
+		Utils::RecordAllocationDestroyed(m_Allocator, allocation);
 		vmaDestroyBuffer(m_Allocator, buffer, allocation);
 	}
 
@@ -285,13 +674,8 @@ namespace Eruption
 		ER_CORE_ASSERT(image);
 		ER_CORE_ASSERT(allocation);
 
-#ifdef ER_DEBUG
-		{
-			std::lock_guard lock(m_TrackerMutex);
-			m_AllocationTracker.erase(allocation);
-		}
-#endif
-
+		m_Tracker.Untrack(allocation);
+		Utils::RecordAllocationDestroyed(m_Allocator, allocation);
 		vmaDestroyImage(m_Allocator, static_cast<VkImage>(image), allocation);
 	}
 
@@ -299,13 +683,8 @@ namespace Eruption
 	{
 		ER_CORE_ASSERT(allocation);
 
-#ifdef ER_DEBUG
-		{
-			std::lock_guard lock(m_TrackerMutex);
-			m_AllocationTracker.erase(allocation);
-		}
-#endif
-
+		m_Tracker.Untrack(allocation);
+		Utils::RecordAllocationDestroyed(m_Allocator, allocation);
 		vmaFreeMemory(m_Allocator, allocation);
 	}
 
@@ -321,6 +700,40 @@ namespace Eruption
 		VK_CHECK_RESULT(vmaInvalidateAllocation(m_Allocator, allocation, offset, size));
 	}
 
+	void VulkanAllocator::QueueFlush(VmaAllocation allocation, vk::DeviceSize offset, vk::DeviceSize size)
+	{
+		VkMemoryPropertyFlags memoryFlags;
+		vmaGetAllocationMemoryProperties(m_Allocator, allocation, &memoryFlags);
+		if (memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+			return;
+
+		std::lock_guard lock(m_FlushMutex);
+		m_FlushAllocations.push_back(allocation);
+		m_FlushOffsets.push_back(offset);
+		m_FlushSizes.push_back(size);
+	}
+
+	void VulkanAllocator::FlushMappedRanges()
+	{
+		ER_PROFILE_FUNCTION();
+
+		std::lock_guard lock(m_FlushMutex);
+		if (m_FlushAllocations.empty())
+			return;
+
+		VK_CHECK_RESULT(vmaFlushAllocations(
+		    m_Allocator,
+		    static_cast<uint32_t>(m_FlushAllocations.size()),
+		    m_FlushAllocations.data(),
+		    m_FlushOffsets.data(),
+		    m_FlushSizes.data()
+		));
+
+		m_FlushAllocations.clear();
+		m_FlushOffsets.clear();
+		m_FlushSizes.clear();
+	}
+
 	AllocationInfo VulkanAllocator::GetAllocationInfo(VmaAllocation allocation) const
 	{
 		VmaAllocationInfo vmaInfo;
@@ -337,15 +750,9 @@ namespace Eruption
 
 	void VulkanAllocator::SetAllocationName(VmaAllocation allocation, std::string_view name)
 	{
-		vmaSetAllocationName(m_Allocator, allocation, name.data());
-
-#ifdef ER_DEBUG
-		{
-			std::lock_guard lock(m_TrackerMutex);
-			if (const auto it = m_AllocationTracker.find(allocation); it != m_AllocationTracker.end())
-				it->second.Name = name;
-		}
-#endif
+		// VMA copies the name, but needs it null-terminated
+		const std::string terminatedName(name);
+		m_Tracker.SetName(m_Allocator, allocation, terminatedName.c_str());
 	}
 
 	void VulkanAllocator::SetAllocationUserData(VmaAllocation allocation, void* userData) const
@@ -383,6 +790,37 @@ namespace Eruption
 		return result;
 	}
 
+	MemoryPoolStats VulkanAllocator::CalculatePoolStats(VmaPool pool) const
+	{
+		VmaDetailedStatistics stats;
+		vmaCalculatePoolStatistics(m_Allocator, pool, &stats);
+
+		const char* name = nullptr;
+		vmaGetPoolName(m_Allocator, pool, &name);
+
+		return MemoryPoolStats{
+		    .Name               = name ? name : "",
+		    .BlockCount         = stats.statistics.blockCount,
+		    .AllocationCount    = stats.statistics.allocationCount,
+		    .BlockBytes         = stats.statistics.blockBytes,
+		    .AllocationBytes    = stats.statistics.allocationBytes,
+		    .UnusedRangeCount   = stats.unusedRangeCount,
+		    .LargestUnusedRange = stats.unusedRangeCount > 0 ? stats.unusedRangeSizeMax : 0
+		};
+	}
+
+	std::vector<MemoryPoolStats> VulkanAllocator::CalculatePoolStats() const
+	{
+		std::lock_guard lock(m_PoolMutex);
+
+		std::vector<MemoryPoolStats> result;
+		result.reserve(m_Pools.size());
+		for (const VmaPool pool : m_Pools | std::views::keys)
+			result.push_back(CalculatePoolStats(pool));
+
+		return result;
+	}
+
 	std::vector<MemoryBudget> VulkanAllocator::GetBudget() const
 	{
 		const Ref<VulkanPhysicalDevice> physicalDevice = m_Device->GetPhysicalDevice();
@@ -419,6 +857,64 @@ namespace Eruption
 		return result;
 	}
 
+	std::vector<AllocationSiteStats> VulkanAllocator::GetAllocationSites() const
+	{
+		return m_Tracker.GetSiteStats(m_Allocator);
+	}
+
+	std::string VulkanAllocator::FormatAllocationsJson() const
+	{
+		const std::vector<AllocationSiteStats> sites = GetAllocationSites();
+
+		uint64_t count = 0, bytes = 0;
+		for (const AllocationSiteStats& site : sites)
+		{
+			count += site.Count;
+			bytes += site.Bytes;
+		}
+
+		std::string out;
+		auto        inserter = std::back_inserter(out);
+
+		std::format_to(
+		    inserter,
+		    "{{\"tracking\":{0},\"allocations\":{1},\"bytes\":{2},\"sites\":[",
+		    VulkanAllocationTracker::IsEnabled(),
+		    count,
+		    bytes
+		);
+
+		for (size_t i = 0; i < sites.size(); ++i)
+		{
+			const AllocationSiteStats& site = sites[i];
+
+			out.append(i == 0 ? "\n{\"tag\":\"" : ",\n{\"tag\":\"");
+			Utils::AppendJsonEscaped(out, site.Tag);
+			out.append("\",\"file\":\"");
+			Utils::AppendJsonEscaped(out, site.File);
+			std::format_to(inserter, "\",\"line\":{0},\"function\":\"", site.Line);
+			Utils::AppendJsonEscaped(out, site.Function);
+			std::format_to(inserter, "\",\"count\":{0},\"bytes\":{1}}}", site.Count, site.Bytes);
+		}
+
+		out.append("\n]}\n");
+		return out;
+	}
+
+	bool VulkanAllocator::WriteAllocationsJson(const std::filesystem::path& path) const
+	{
+		std::error_code error;
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+			return false;
+
+		stream << FormatAllocationsJson();
+		return stream.good();
+	}
+
 	void VulkanAllocator::SetCurrentFrameIndex(uint32_t frameIndex) const
 	{
 		vmaSetCurrentFrameIndex(m_Allocator, frameIndex);
@@ -443,4 +939,44 @@ namespace Eruption
 
 		return memoryTypeIndex;
 	}
+
+	std::optional<uint32_t> VulkanAllocator::FindMemoryTypeIndex(
+	    const vk::BufferCreateInfo& createInfo, MemoryUsage usage, AllocationCreateFlags flags
+	) const
+	{
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.usage = Utils::ConvertMemoryUsage(usage);
+		allocInfo.flags = Utils::ConvertAllocationFlags(Utils::AddPersistentMapping(usage, flags));
+
+		const auto vkCreateInfo = static_cast<VkBufferCreateInfo>(createInfo);
+		uint32_t   memoryTypeIndex;
+		const auto result = static_cast<vk::Result>(
+		    vmaFindMemoryTypeIndexForBufferInfo(m_Allocator, &vkCreateInfo, &allocInfo, &memoryTypeIndex)
+		);
+
+		if (result != vk::Result::eSuccess)
+			return std::nullopt;
+
+		return memoryTypeIndex;
+	}
+
+	std::optional<uint32_t> VulkanAllocator::FindMemoryTypeIndex(
+	    const vk::ImageCreateInfo& createInfo, MemoryUsage usage, AllocationCreateFlags flags
+	) const
+	{
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.usage = Utils::ConvertMemoryUsage(usage);
+		allocInfo.flags = Utils::ConvertAllocationFlags(Utils::AddPersistentMapping(usage, flags));
+
+		const auto vkCreateInfo = static_cast<VkImageCreateInfo>(createInfo);
+		uint32_t   memoryTypeIndex;
+		const auto result = static_cast<vk::Result>(
+		    vmaFindMemoryTypeIndexForImageInfo(m_Allocator, &vkCreateInfo, &allocInfo, &memoryTypeIndex)
+		);
+
+		if (result != vk::Result::eSuccess)
+			return std::nullopt;
+
+		return memoryTypeIndex;
+	}
 }        // namespace Eruption
@@ -7,10 +7,22 @@
 #define VMA_DYNAMIC_VULKAN_FUNCTIONS 1
 #include <vk_mem_alloc.h>
 
+#include <array>
 #include <expected>
+#include <filesystem>
+#include <mutex>
 #include <source_location>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
+
+// Allocations are tracked in debug builds, with the call site that made them
+#ifdef ER_DEBUG
+#	define ER_GPU_ALLOCATION_TRACKING_ENABLED 1
+#else
+#	define ER_GPU_ALLOCATION_TRACKING_ENABLED 0
+#endif
 
 namespace Eruption
 {
@@ -47,6 +59,29 @@ namespace Eruption
 
 	using AllocationCreateFlags = vk::Flags<AllocationCreateFlagBits>;
 
+	enum class MemoryPoolAlgorithm
+	{
+		Tlsf,         // General purpose, for long-lived resources of mixed sizes such as streamed textures
+		Linear        // Freed in allocation order or all at once, for transient data
+	};
+
+	// Custom pools keep one class of resources out of the default pools, so short-lived allocations do not
+	// fragment the blocks holding long-lived ones. Typical setups:
+	//
+	//     Transient data:     Linear, fixed BlockSize, MaxBlockCount = 1 to use it as a ring buffer
+	//     Streaming textures: Tlsf, large BlockSize, MaxBlockCount as the streaming budget
+	//     Uniform buffers:    Tlsf, MinBlockCount = MaxBlockCount, so all blocks are allocated up-front
+	struct MemoryPoolSpecification
+	{
+		std::string           Name;
+		MemoryPoolAlgorithm   Algorithm     = MemoryPoolAlgorithm::Tlsf;
+		MemoryUsage           Usage         = MemoryUsage::Auto;
+		AllocationCreateFlags Flags         = AllocationCreateFlagBits::None;        // Host access, picks memory type
+		vk::DeviceSize        BlockSize     = 0;                                     // 0 lets VMA choose
+		size_t                MinBlockCount = 0;                                     // Allocated up-front, never freed
+		size_t                MaxBlockCount = 0;                                     // 0 is unlimited
+	};
+
 	struct MemoryStats
 	{
 		struct HeapStats
@@ -62,6 +97,17 @@ namespace Eruption
 		std::vector<HeapStats> HeapStats;
 	};
 
+	struct MemoryPoolStats
+	{
+		std::string Name;
+		uint64_t    BlockCount;
+		uint64_t    AllocationCount;
+		uint64_t    BlockBytes;
+		uint64_t    AllocationBytes;
+		uint64_t    UnusedRangeCount;
+		uint64_t    LargestUnusedRange;        // Much smaller than the free bytes means the pool is fragmented
+	};
+
 	struct MemoryBudget
 	{
 		uint64_t BlockBytes;
@@ -79,6 +125,59 @@ namespace Eruption
 		void*    UserData;
 	};
 
+	// Live allocations made from one call site with one name
+	struct AllocationSiteStats
+	{
+		std::string Tag;        // Allocation name, or the resource kind when it has none
+		std::string File;
+		std::string Function;
+		uint32_t    Line  = 0;
+		uint64_t    Count = 0;
+		uint64_t    Bytes = 0;
+	};
+
+	// Records every live allocation with the source location it was made from. Entries are spread over shards
+	// by handle, each with its own lock, so threads allocating concurrently rarely wait on each other. Entries
+	// hold no strings: names are read back from VMA, which keeps its own copy, when the stats are gathered, so
+	// renames go through SetName to replace that copy under the same lock.
+	class VulkanAllocationTracker
+	{
+	public:
+		[[nodiscard]] static constexpr bool IsEnabled() { return ER_GPU_ALLOCATION_TRACKING_ENABLED; }
+
+		// The kind must be a string literal
+		void Track(VmaAllocation allocation, vk::DeviceSize size, const char* kind, std::source_location location);
+		void Untrack(VmaAllocation allocation);
+
+		// Sets the VMA name under the allocation's shard lock, as GetSiteStats reads it under that lock too
+		void SetName(VmaAllocator allocator, VmaAllocation allocation, const char* name);
+
+		[[nodiscard]] size_t GetCount() const;
+
+		// Sorted by live bytes
+		[[nodiscard]] std::vector<AllocationSiteStats> GetSiteStats(VmaAllocator allocator) const;
+
+	private:
+		static constexpr uint32_t SHARD_COUNT = 16;
+
+		struct Entry
+		{
+			vk::DeviceSize       Size;
+			const char*          Kind;
+			std::source_location Location;
+		};
+
+		struct alignas(64) Shard
+		{
+			mutable std::mutex                       Mutex;
+			std::unordered_map<VmaAllocation, Entry> Entries;
+		};
+
+		[[nodiscard]] static uint32_t GetShardIndex(VmaAllocation allocation);
+
+		std::array<Shard, SHARD_COUNT> m_Shards;
+	};
+
 	class VulkanAllocator
 	{
 	public:
@@ -97,16 +196,61 @@ namespace Eruption
 		    const vk::BufferCreateInfo& createInfo,
 		    MemoryUsage                 usage,
 		    vk::Buffer&                 outBuffer,
-		    AllocationCreateFlags       flags = AllocationCreateFlagBits::None
+		    AllocationCreateFlags       flags    = AllocationCreateFlagBits::None,
+		    std::source_location        location = std::source_location::current()
 		);
 
 		[[nodiscard]] std::expected<VmaAllocation, vk::Result> AllocateImage(
 		    const vk::ImageCreateInfo& createInfo,
 		    MemoryUsage                usage,
 		    vk::Image&                 outImage,
-		    AllocationCreateFlags      flags = AllocationCreateFlagBits::None
+		    AllocationCreateFlags      flags    = AllocationCreateFlagBits::None,
+		    std::source_location       location = std::source_location::current()
+		);
+
+		// Allocates from a custom pool, whose memory type takes the place of the memory usage
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> AllocateBuffer(
+		    const vk::BufferCreateInfo& createInfo,
+		    VmaPool                     pool,
+		    vk::Buffer&                 outBuffer,
+		    AllocationCreateFlags       flags    = AllocationCreateFlagBits::None,
+		    std::source_location        location = std::source_location::current()
 		);
 
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> AllocateImage(
+		    const vk::ImageCreateInfo& createInfo,
+		    VmaPool                    pool,
+		    vk::Image&                 outImage,
+		    AllocationCreateFlags      flags    = AllocationCreateFlagBits::None,
+		    std::source_location       location = std::source_location::current()
+		);
+
+		// Memory without a resource, resources are placed in it with BindBufferMemory and BindImageMemory.
+		// Pass CanAlias when several resources will share the same range.
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> AllocateMemory(
+		    const vk::MemoryRequirements& requirements,
+		    vk::MemoryPropertyFlags       requiredFlags,
+		    AllocationCreateFlags         flags    = AllocationCreateFlagBits::None,
+		    std::source_location          location = std::source_location::current()
+		);
+
+		// The offset is relative to the allocation and must respect the resource's alignment
+		void BindBufferMemory(VmaAllocation allocation, vk::DeviceSize offset, vk::Buffer buffer) const;
+		void BindImageMemory(VmaAllocation allocation, vk::DeviceSize offset, vk::Image image) const;
+
+		// The example describes the resources the pool will hold and selects its memory type
+		[[nodiscard]] std::expected<VmaPool, vk::Result> CreatePool(
+		    const MemoryPoolSpecification& specification, const vk::BufferCreateInfo& exampleCreateInfo
+		);
+		[[nodiscard]] std::expected<VmaPool, vk::Result> CreatePool(
+		    const MemoryPoolSpecification& specification, const vk::ImageCreateInfo& exampleCreateInfo
+		);
+
+		// All allocations of the pool must have been freed
+		void DestroyPool(VmaPool pool);
+
+		// Host-visible allocations are created persistently mapped, read their pointer from GetAllocationInfo
+		// rather than mapping them. Mapping one only takes a reference, but still costs a call into VMA.
 		template <typename T = void>
 		[[nodiscard]] T* MapMemory(VmaAllocation allocation)
 		{
@@ -128,37 +272,78 @@ namespace Eruption
 		    VmaAllocation allocation, vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE
 		) const;
 
+		// Queues a range written through a mapped pointer, to be flushed with all others by FlushMappedRanges.
+		// Ranges in host-coherent memory need no flush and are dropped. Only for the per-frame rings, which queue
+		// in their EndFrame right before VulkanContext::EndFrame flushes; anything submitted earlier, or whose
+		// allocation may be freed before then, must use FlushAllocation.
+		void QueueFlush(VmaAllocation allocation, vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE);
+
+		// Flushes the queued ranges in one call, once per frame before the frame's command buffers are submitted
+		void FlushMappedRanges();
+
 		[[nodiscard]] AllocationInfo GetAllocationInfo(VmaAllocation allocation) const;
 		void                         SetAllocationName(VmaAllocation allocation, std::string_view name);
 		void                         SetAllocationUserData(VmaAllocation allocation, void* userData) const;
 
-		[[nodiscard]] MemoryStats               CalculateStats() const;
-		[[nodiscard]] std::vector<MemoryBudget> GetBudget() const;
-		[[nodiscard]] std::string               BuildStatsString(bool detailed = false) const;
-		void                                    SetCurrentFrameIndex(uint32_t frameIndex) const;
+		[[nodiscard]] MemoryStats                      CalculateStats() const;
+		[[nodiscard]] MemoryPoolStats                  CalculatePoolStats(VmaPool pool) const;
+		[[nodiscard]] std::vector<MemoryPoolStats>     CalculatePoolStats() const;
+		[[nodiscard]] std::vector<MemoryBudget>        GetBudget() const;
+		[[nodiscard]] std::string                      BuildStatsString(bool detailed = false) const;
+		[[nodiscard]] std::vector<AllocationSiteStats> GetAllocationSites() const;
+		void                                           SetCurrentFrameIndex(uint32_t frameIndex) const;
 
 		[[nodiscard]] std::optional<uint32_t> FindMemoryTypeIndex(
 		    uint32_t memoryTypeBits, vk::MemoryPropertyFlags requiredFlags
 		) const;
 
+		// The memory type AllocateBuffer/AllocateImage try first for the same arguments
+		[[nodiscard]] std::optional<uint32_t> FindMemoryTypeIndex(
+		    const vk::BufferCreateInfo& createInfo, MemoryUsage usage, AllocationCreateFlags flags
+		) const;
+		[[nodiscard]] std::optional<uint32_t> FindMemoryTypeIndex(
+		    const vk::ImageCreateInfo& createInfo, MemoryUsage usage, AllocationCreateFlags flags
+		) const;
+
+		// Live allocations grouped by call site and name, empty unless allocation tracking is enabled
+		[[nodiscard]] std::string FormatAllocationsJson() const;
+		bool                      WriteAllocationsJson(const std::filesystem::path& path) const;
+
 		[[nodiscard]] VmaAllocator GetVmaAllocator() const { return m_Allocator; }
 
+	private:
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> CreateBuffer(
+		    const vk::BufferCreateInfo&    createInfo,
+		    const VmaAllocationCreateInfo& allocInfo,
+		    vk::Buffer&                    outBuffer,
+		    std::source_location           location
+		);
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> CreateImage(
+		    const vk::ImageCreateInfo&     createInfo,
+		    const VmaAllocationCreateInfo& allocInfo,
+		    vk::Image&                     outImage,
+		    std::source_location           location
+		);
+
+		[[nodiscard]] std::expected<VmaPool, vk::Result> CreatePool(
+		    const MemoryPoolSpecification& specification, uint32_t memoryTypeIndex
+		);
+
 	private:
 		Ref<VulkanDevice> m_Device;
 
 		VmaAllocator m_Allocator = VK_NULL_HANDLE;
 
-#ifdef ER_DEBUG
-		struct AllocationTracker
-		{
-			vk::DeviceSize       Size;
-			std::string          Name;
-			std::source_location Location;
-		};
-		std::unordered_map<VmaAllocation, AllocationTracker> m_AllocationTracker;
+		std::unordered_map<VmaPool, std::string> m_Pools;
+		mutable std::mutex                       m_PoolMutex;
 
-		mutable std::mutex m_TrackerMutex;
-#endif
+		// Ranges queued by QueueFlush, as vmaFlushAllocations takes them
+		std::vector<VmaAllocation>  m_FlushAllocations;
+		std::vector<vk::DeviceSize> m_FlushOffsets;
+		std::vector<vk::DeviceSize> m_FlushSizes;
+		std::mutex                  m_FlushMutex;
+
+		VulkanAllocationTracker m_Tracker;
 	};
 
 	template <typename T>
@@ -172,7 +357,9 @@ namespace Eruption
 	public:
 		VulkanAllocation() = default;
 		VulkanAllocation(VulkanAllocator* allocator, VmaAllocation allocation) :
-		    m_Allocator(allocator), m_Allocation(allocation)
+		    m_Allocator(allocator),
+		    m_Allocation(allocation),
+		    m_PersistentlyMapped(allocator && allocation && allocator->GetAllocationInfo(allocation).MappedData)
 		{}
 
 		~VulkanAllocation()
@@ -184,7 +371,9 @@ namespace Eruption
 		VulkanAllocation(const VulkanAllocation&)            = delete;
 		VulkanAllocation& operator=(const VulkanAllocation&) = delete;
 		VulkanAllocation(VulkanAllocation&& other) noexcept :
-		    m_Allocator(other.m_Allocator), m_Allocation(std::exchange(other.m_Allocation, nullptr))
+		    m_Allocator(other.m_Allocator),
+		    m_Allocation(std::exchange(other.m_Allocation, nullptr)),
+		    m_PersistentlyMapped(std::exchange(other.m_PersistentlyMapped, false))
 		{}
 		VulkanAllocation& operator=(VulkanAllocation&& other) noexcept
 		{
@@ -192,31 +381,51 @@ namespace Eruption
 			{
 				if (m_Allocation && m_Allocator)
 					m_Allocator->FreeMemory(m_Allocation);
-				m_Allocator  = other.m_Allocator;
-				m_Allocation = std::exchange(other.m_Allocation, nullptr);
+				m_Allocator          = other.m_Allocator;
+				m_Allocation         = std::exchange(other.m_Allocation, nullptr);
+				m_PersistentlyMapped = std::exchange(other.m_PersistentlyMapped, false);
 			}
 			return *this;
 		}
 
 		[[nodiscard]] VmaAllocation Get() const { return m_Allocation; }
-		[[nodiscard]] VmaAllocation Release() { return std::exchange(m_Allocation, nullptr); }
-		[[nodiscard]] bool          IsValid() const { return m_Allocation != VK_NULL_HANDLE; }
+		[[nodiscard]] VmaAllocation Release()
+		{
+			m_PersistentlyMapped = false;
+			return std::exchange(m_Allocation, nullptr);
+		}
+		[[nodiscard]] bool IsValid() const { return m_Allocation != VK_NULL_HANDLE; }
+		[[nodiscard]] bool IsPersistentlyMapped() const { return m_PersistentlyMapped; }
 
+		// Persistently mapped allocations return their current pointer, which changes when the defragmenter
+		// moves them, so do not keep it across frames. Unmap is then a no-op.
 		template <typename T = void>
 		[[nodiscard]] T* Map()
 		{
+			if (m_PersistentlyMapped)
+				return static_cast<T*>(m_Allocator->GetAllocationInfo(m_Allocation).MappedData);
+
 			return m_Allocator ? m_Allocator->MapMemory<T>(m_Allocation) : nullptr;
 		}
 
 		void Unmap() const
 		{
-			if (m_Allocator && m_Allocation)
+			if (!m_PersistentlyMapped && m_Allocator && m_Allocation)
 				m_Allocator->UnmapMemory(m_Allocation);
 		}
 
+		// Flushes right away, so the writes are visible to anything submitted after it. VMA skips host-coherent
+		// memory.
+		void Flush(vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE) const
+		{
+			if (m_Allocator && m_Allocation)
+				m_Allocator->FlushAllocation(m_Allocation, offset, size);
+		}
+
 	private:
-		VulkanAllocator* m_Allocator  = nullptr;
-		VmaAllocation    m_Allocation = VK_NULL_HANDLE;
+		VulkanAllocator* m_Allocator          = nullptr;
+		VmaAllocation    m_Allocation         = VK_NULL_HANDLE;
+		bool             m_PersistentlyMapped = false;
 	};
 
 }        // namespace Eruption
@@ -0,0 +1,77 @@
+#include "VulkanCallCounters.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+#include <atomic>
+
+namespace Eruption
+{
+	namespace
+	{
+		struct CallInfo
+		{
+			const char* Name;
+			const char* MetricName;
+		};
+
+		constexpr std::array<CallInfo, VULKAN_CALL_COUNT> CALLS = {{
+		    {"Queue submits", "eruption_vulkan_queue_submits_total"},
+		    {"Command buffers allocated", "eruption_vulkan_command_buffers_allocated_total"},
+		    {"Pipeline binds", "eruption_vulkan_pipeline_binds_total"},
+		    {"Descriptor set binds", "eruption_vulkan_descriptor_set_binds_total"},
+		    {"Draws", "eruption_vulkan_draws_total"},
+		    {"Dispatches", "eruption_vulkan_dispatches_total"},
+		    {"Pipeline barriers", "eruption_vulkan_pipeline_barriers_total"},
+		    {"Fences created", "eruption_vulkan_fences_created_total"},
+		    {"Queue lock waits", "eruption_vulkan_queue_lock_waits_total"},
+		}};
+
+		std::array<MetricCounter*, VULKAN_CALL_COUNT>& GetCounters()
+		{
+			static std::array<MetricCounter*, VULKAN_CALL_COUNT> s_Counters = [] {
+				std::array<MetricCounter*, VULKAN_CALL_COUNT> counters{};
+				for (size_t i = 0; i < VULKAN_CALL_COUNT; ++i)
+					counters[i] = &Metrics::GetPerFrameCounter(CALLS[i].MetricName, CALLS[i].Name);
+
+				return counters;
+			}();
+
+			return s_Counters;
+		}
+
+		// Written by MarkFrame on the main thread, read from anywhere
+		std::array<uint64_t, VULKAN_CALL_COUNT>              s_PreviousTotals{};
+		std::array<std::atomic<uint64_t>, VULKAN_CALL_COUNT> s_LastFrame{};
+	}        // namespace
+
+	void VulkanCallCounters::Increment(VulkanCall call, uint64_t count)
+	{
+		GetCounters()[static_cast<size_t>(call)]->Increment(count);
+	}
+
+	void VulkanCallCounters::MarkFrame()
+	{
+		const auto& counters = GetCounters();
+
+		for (size_t i = 0; i < VULKAN_CALL_COUNT; ++i)
+		{
+			const uint64_t total = counters[i]->GetValue();
+			s_LastFrame[i].store(total - s_PreviousTotals[i], std::memory_order_relaxed);
+			s_PreviousTotals[i] = total;
+		}
+	}
+
+	VulkanCallStats VulkanCallCounters::GetLastFrameStats()
+	{
+		VulkanCallStats stats;
+		for (size_t i = 0; i < VULKAN_CALL_COUNT; ++i)
+			stats.Counts[i] = s_LastFrame[i].load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	const char* VulkanCallCounters::GetName(VulkanCall call)
+	{
+		return CALLS[static_cast<size_t>(call)].Name;
+	}
+}        // namespace Eruption
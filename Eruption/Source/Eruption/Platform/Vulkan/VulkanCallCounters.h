@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Eruption
+{
+	enum class VulkanCall : uint8_t
+	{
+		QueueSubmit = 0,
+		CommandBufferAllocate,
+		PipelineBind,
+		DescriptorSetBind,
+		Draw,
+		Dispatch,
+		PipelineBarrier,
+		FenceCreate,
+		QueueLockWait,        // LockQueue found the queue held by another thread
+
+		Count
+	};
+
+	inline constexpr size_t VULKAN_CALL_COUNT = static_cast<size_t>(VulkanCall::Count);
+
+	struct VulkanCallStats
+	{
+		std::array<uint64_t, VULKAN_CALL_COUNT> Counts{};
+
+		[[nodiscard]] uint64_t operator[](VulkanCall call) const { return Counts[static_cast<size_t>(call)]; }
+	};
+
+	// Per-frame counts of the Vulkan calls made through the counted entry points: submits, fences and queue
+	// locks of VulkanDevice, allocations of VulkanCommandPool and the recording calls of VulkanCommandBuffer.
+	// Each call also feeds the <name>_per_frame metric of the same name.
+	class VulkanCallCounters
+	{
+	public:
+		static void Increment(VulkanCall call, uint64_t count = 1);
+
+		// Closes the current frame, called once per frame by the application loop
+		static void MarkFrame();
+
+		[[nodiscard]] static VulkanCallStats GetLastFrameStats();
+
+		[[nodiscard]] static const char* GetName(VulkanCall call);
+	};
+}        // namespace Eruption
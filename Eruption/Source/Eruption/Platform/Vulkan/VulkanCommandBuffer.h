@@ -0,0 +1,105 @@
+#pragma once
+#include "Eruption/Platform/Vulkan/Vulkan.h"
+#include "Eruption/Platform/Vulkan/VulkanCallCounters.h"
+
+namespace Eruption
+{
+	// Non-owning wrapper over a command buffer that forwards to Vulkan-Hpp and counts the calls tracked by
+	// VulkanCallCounters. Record through it instead of the raw handle so API overhead shows up in the frame
+	// statistics; anything not wrapped is reachable through Get().
+	class VulkanCommandBuffer
+	{
+	public:
+		VulkanCommandBuffer() = default;
+		VulkanCommandBuffer(vk::CommandBuffer commandBuffer) : m_CommandBuffer(commandBuffer) {}
+
+		void BindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::PipelineBind);
+			m_CommandBuffer.bindPipeline(bindPoint, pipeline);
+		}
+
+		void BindDescriptorSets(
+		    vk::PipelineBindPoint                          bindPoint,
+		    vk::PipelineLayout                             layout,
+		    uint32_t                                       firstSet,
+		    vk::ArrayProxy<const vk::DescriptorSet> const& descriptorSets,
+		    vk::ArrayProxy<const uint32_t> const&          dynamicOffsets = {}
+		) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::DescriptorSetBind);
+			m_CommandBuffer.bindDescriptorSets(bindPoint, layout, firstSet, descriptorSets, dynamicOffsets);
+		}
+
+		void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::Draw);
+			m_CommandBuffer.draw(vertexCount, instanceCount, firstVertex, firstInstance);
+		}
+
+		void DrawIndexed(
+		    uint32_t indexCount,
+		    uint32_t instanceCount,
+		    uint32_t firstIndex,
+		    int32_t  vertexOffset,
+		    uint32_t firstInstance
+		) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::Draw);
+			m_CommandBuffer.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+		}
+
+		// Counted once per call, the draw count is only known to the GPU
+		void DrawIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::Draw);
+			m_CommandBuffer.drawIndirect(buffer, offset, drawCount, stride);
+		}
+
+		void DrawIndexedIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::Draw);
+			m_CommandBuffer.drawIndexedIndirect(buffer, offset, drawCount, stride);
+		}
+
+		void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::Dispatch);
+			m_CommandBuffer.dispatch(groupCountX, groupCountY, groupCountZ);
+		}
+
+		void DispatchIndirect(vk::Buffer buffer, vk::DeviceSize offset) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::Dispatch);
+			m_CommandBuffer.dispatchIndirect(buffer, offset);
+		}
+
+		void PipelineBarrier(const vk::DependencyInfo& dependencyInfo) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::PipelineBarrier);
+			m_CommandBuffer.pipelineBarrier2(dependencyInfo);
+		}
+
+		// Vulkan 1.0 barrier, for code that does not rely on synchronization2
+		void PipelineBarrier(
+		    vk::PipelineStageFlags                               srcStageMask,
+		    vk::PipelineStageFlags                               dstStageMask,
+		    vk::DependencyFlags                                  dependencyFlags,
+		    vk::ArrayProxy<const vk::MemoryBarrier> const&       memoryBarriers,
+		    vk::ArrayProxy<const vk::BufferMemoryBarrier> const& bufferMemoryBarriers,
+		    vk::ArrayProxy<const vk::ImageMemoryBarrier> const&  imageMemoryBarriers
+		) const
+		{
+			VulkanCallCounters::Increment(VulkanCall::PipelineBarrier);
+			m_CommandBuffer.pipelineBarrier(
+			    srcStageMask, dstStageMask, dependencyFlags, memoryBarriers, bufferMemoryBarriers, imageMemoryBarriers
+			);
+		}
+
+		[[nodiscard]] vk::CommandBuffer Get() const { return m_CommandBuffer; }
+		operator vk::CommandBuffer() const { return m_CommandBuffer; }
+
+	private:
+		vk::CommandBuffer m_CommandBuffer;
+	};
+}        // namespace Eruption
@@ -1,11 +1,21 @@
 #include "VulkanContext.h"
 
+#include "Eruption/Debug/Telemetry.h"
+
+#include <array>
+#include <cctype>
+#include <string_view>
+
 namespace Eruption
 {
 	namespace Utils
 	{
 		namespace
 		{
+			// Repeats of the same validation message are logged at most this often
+			constexpr uint32_t VALIDATION_MESSAGE_INTERVAL_MS = 1000;
+			constexpr uint32_t VALIDATION_LIMITER_COUNT       = 256;
+
 			bool CheckDriverAPIVersionSupport(uint32_t minimumSupportedVersion)
 			{
 				const uint32_t instanceVersion = vk::enumerateInstanceVersion();
@@ -31,6 +41,36 @@ namespace Eruption
 				return true;
 			}
 
+			// FNV-1a over the text without its numbers, as handles and addresses differ between repeats of a message
+			uint64_t HashWithoutNumbers(std::string_view text)
+			{
+				uint64_t hash = 14695981039346656037ull;
+				for (size_t i = 0; i < text.size(); ++i)
+				{
+					if (std::isdigit(static_cast<unsigned char>(text[i])))
+					{
+						// Also skips the rest of hex handles such as 0x7f3a2c
+						while (i + 1 < text.size() &&
+						       (std::isxdigit(static_cast<unsigned char>(text[i + 1])) || text[i + 1] == 'x'))
+							++i;
+						continue;
+					}
+
+					hash = (hash ^ static_cast<unsigned char>(text[i])) * 1099511628211ull;
+				}
+				return hash;
+			}
+
+			// Loader and layer messages often share ID 0, so the name tells messages apart and, for ID 0, the text
+			uint64_t GetValidationMessageKey(const vk::DebugUtilsMessengerCallbackDataEXT& data)
+			{
+				uint64_t key = HashWithoutNumbers(data.pMessageIdName ? data.pMessageIdName : "");
+				if (data.messageIdNumber == 0 && data.pMessage)
+					key = key * 31 + HashWithoutNumbers(data.pMessage);
+
+				return key * 31 + static_cast<uint32_t>(data.messageIdNumber);
+			}
+
 			vk::Bool32 VulkanDebugUtilsMessengerCallback(
 			    vk::DebugUtilsMessageSeverityFlagBitsEXT      messageSeverity,
 			    vk::DebugUtilsMessageTypeFlagsEXT             messageTypes,
@@ -38,6 +78,20 @@ namespace Eruption
 			    [[maybe_unused]] void*                        pUserData
 			)
 			{
+				// A call site limiter would let one noisy message hide all others, so limit per message. The table is
+				// fixed, so messages that collide share a limiter instead of the table growing. Errors are never
+				// limited.
+				static std::array<LogLimiter, VALIDATION_LIMITER_COUNT> s_Limiters;
+
+				uint64_t suppressed = 0;
+				if (messageSeverity != vk::DebugUtilsMessageSeverityFlagBitsEXT::eError)
+				{
+					const uint64_t key     = GetValidationMessageKey(*pCallbackData);
+					LogLimiter&    limiter = s_Limiters[key % VALIDATION_LIMITER_COUNT];
+					if (!limiter.ShouldLogRateLimited(VALIDATION_MESSAGE_INTERVAL_MS, suppressed))
+						return VK_FALSE;
+				}
+
 				std::string labels, objects;
 				if (pCallbackData->cmdBufLabelCount)
 				{
@@ -77,7 +131,7 @@ namespace Eruption
 					}
 				}
 
-				const std::string message = std::format(
+				std::string message = std::format(
 				    "{0} {1} message: \n\t{2}\n {3} {4}",
 				    vk::to_string(messageTypes),
 				    vk::to_string(messageSeverity),
@@ -86,6 +140,9 @@ namespace Eruption
 				    objects
 				);
 
+				if (suppressed > 0)
+					message.append(std::format("\t(suppressed {0} repeats of this message)", suppressed));
+
 				switch (messageSeverity)
 				{
 					case vk::DebugUtilsMessageSeverityFlagBitsEXT::eVerbose:
@@ -164,6 +221,18 @@ namespace Eruption
 
 	VulkanContext::~VulkanContext()
 	{
+		// Objects still waiting in the deletion queue may be in use by the last frames
+		m_Device->GetVulkanDevice().waitIdle();
+		m_DeletionQueue.reset();
+
+		m_GeometryBuffer.reset();
+		m_ResidencyManager.reset();
+		m_Defragmenter.reset();
+		m_FrameDataAllocator.reset();
+		m_StagingRing.reset();
+		m_PipelineStatistics.reset();
+		m_GpuProfiler.reset();
+
 		m_Allocator->Destroy();
 		m_Device->Destroy();
 
@@ -248,6 +317,66 @@ namespace Eruption
 		m_Allocator->Init(m_VulkanInstance, m_Device);
 
 		m_PipelineCache = m_Device->GetVulkanDevice().createPipelineCache(vk::PipelineCacheCreateInfo{});
+
+		const RendererConfig& config         = Renderer::GetConfig();
+		const uint32_t        framesInFlight = config.FramesInFlight;
+
+		m_GpuProfiler        = CreateScope<VulkanGpuProfiler>(m_Device, framesInFlight);
+		m_PipelineStatistics = CreateScope<VulkanPipelineStatistics>(m_Device, framesInFlight);
+		m_StagingRing        = CreateScope<VulkanStagingRing>(m_Allocator, framesInFlight, config.StagingBufferSize);
+		m_FrameDataAllocator = CreateScope<VulkanFrameDataAllocator>(
+		    m_Device, m_Allocator, framesInFlight, config.FrameDataBufferSize
+		);
+		m_Defragmenter     = CreateScope<VulkanDefragmenter>(m_Device, m_Allocator);
+		m_DeletionQueue    = CreateScope<VulkanDeletionQueue>(m_Device, m_Allocator, framesInFlight);
+		m_ResidencyManager = CreateScope<VulkanResidencyManager>(
+		    m_Device, m_Allocator, framesInFlight, config.MemoryEvictionThreshold, config.MemoryEvictionTarget
+		);
+		m_GeometryBuffer = CreateScope<VulkanGlobalGeometryBuffer>(
+		    m_Allocator, config.GeometryVertexPageSize, config.GeometryIndexPageSize
+		);
+	}
+
+	void VulkanContext::BeginFrame(uint32_t frameIndex)
+	{
+		ER_PROFILE_FUNCTION();
+
+		// No frame submits GPU work yet, every submission waits on its own fence. Once the render loop submits
+		// frames, this has to run after the fence of the frame previously using the slot has been waited on.
+		m_DeletionQueue->BeginFrame(frameIndex);
+		m_ResidencyManager->BeginFrame();
+		m_StagingRing->BeginFrame(frameIndex);
+		m_FrameDataAllocator->BeginFrame(frameIndex);
+	}
+
+	void VulkanContext::EndFrame()
+	{
+		ER_PROFILE_FUNCTION();
+
+		m_StagingRing->EndFrame();
+		m_FrameDataAllocator->EndFrame();
+
+		// Writes of the whole frame to non-coherent memory, flushed in one call before the frame is submitted
+		m_Allocator->FlushMappedRanges();
+	}
+
+	void VulkanContext::PublishTelemetry() const
+	{
+		if (!m_Allocator)
+			return;
+
+		const std::vector<MemoryBudget> budgets = m_Allocator->GetBudget();
+		for (uint32_t i = 0; i < budgets.size(); ++i)
+		{
+			Telemetry::PublishMemoryBudget(
+			    {.HeapIndex       = i,
+			     .HeapCount       = static_cast<uint32_t>(budgets.size()),
+			     .BlockBytes      = budgets[i].BlockBytes,
+			     .AllocationBytes = budgets[i].AllocationBytes,
+			     .Usage           = budgets[i].Usage,
+			     .Budget          = budgets[i].Budget}
+			);
+		}
 	}
 
 	void VulkanContext::CreateSurface(GLFWwindow* window)
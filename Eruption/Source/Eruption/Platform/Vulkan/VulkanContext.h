@@ -1,6 +1,14 @@
 #pragma once
 #include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+#include "Eruption/Platform/Vulkan/VulkanDefragmenter.h"
+#include "Eruption/Platform/Vulkan/VulkanDeletionQueue.h"
 #include "Eruption/Platform/Vulkan/VulkanDevice.h"
+#include "Eruption/Platform/Vulkan/VulkanFrameDataAllocator.h"
+#include "Eruption/Platform/Vulkan/VulkanGlobalGeometryBuffer.h"
+#include "Eruption/Platform/Vulkan/VulkanGpuProfiler.h"
+#include "Eruption/Platform/Vulkan/VulkanPipelineStatistics.h"
+#include "Eruption/Platform/Vulkan/VulkanResidencyManager.h"
+#include "Eruption/Platform/Vulkan/VulkanStagingRing.h"
 
 #include "Eruption/Renderer/Renderer.h"
 #include "Eruption/Renderer/RendererContext.h"
@@ -40,11 +48,22 @@ namespace Eruption
 		~VulkanContext() override;
 
 		void Create(GLFWwindow* window) override;
-
-		[[nodiscard]] vk::Instance         GetVulkanInstance() const { return m_VulkanInstance; }
-		[[nodiscard]] Ref<VulkanDevice>    GetDevice() const { return m_Device; }
-		[[nodiscard]] Ref<VulkanAllocator> GetAllocator() const { return m_Allocator; }
-		[[nodiscard]] vk::SurfaceKHR       GetSurface() const { return m_Surface; }
+		void BeginFrame(uint32_t frameIndex) override;
+		void EndFrame() override;
+		void PublishTelemetry() const override;
+
+		[[nodiscard]] vk::Instance                GetVulkanInstance() const { return m_VulkanInstance; }
+		[[nodiscard]] Ref<VulkanDevice>           GetDevice() const { return m_Device; }
+		[[nodiscard]] Ref<VulkanAllocator>        GetAllocator() const { return m_Allocator; }
+		[[nodiscard]] vk::SurfaceKHR              GetSurface() const { return m_Surface; }
+		[[nodiscard]] VulkanGpuProfiler&          GetGpuProfiler() const { return *m_GpuProfiler; }
+		[[nodiscard]] VulkanPipelineStatistics&   GetPipelineStatistics() const { return *m_PipelineStatistics; }
+		[[nodiscard]] VulkanStagingRing&          GetStagingRing() const { return *m_StagingRing; }
+		[[nodiscard]] VulkanFrameDataAllocator&   GetFrameDataAllocator() const { return *m_FrameDataAllocator; }
+		[[nodiscard]] VulkanDefragmenter&         GetDefragmenter() const { return *m_Defragmenter; }
+		[[nodiscard]] VulkanDeletionQueue&        GetDeletionQueue() const { return *m_DeletionQueue; }
+		[[nodiscard]] VulkanResidencyManager&     GetResidencyManager() const { return *m_ResidencyManager; }
+		[[nodiscard]] VulkanGlobalGeometryBuffer& GetGeometryBuffer() const { return *m_GeometryBuffer; }
 
 		[[nodiscard]] Ref<vk::detail::DispatchLoaderDynamic> GetDLD() const { return m_DispatchLoaderDynamic; }
 
@@ -61,6 +80,15 @@ namespace Eruption
 		Ref<VulkanDevice>         m_Device;
 		Ref<VulkanAllocator>      m_Allocator;
 
+		Scope<VulkanGpuProfiler>          m_GpuProfiler;
+		Scope<VulkanPipelineStatistics>   m_PipelineStatistics;
+		Scope<VulkanStagingRing>          m_StagingRing;
+		Scope<VulkanFrameDataAllocator>   m_FrameDataAllocator;
+		Scope<VulkanDefragmenter>         m_Defragmenter;
+		Scope<VulkanDeletionQueue>        m_DeletionQueue;
+		Scope<VulkanResidencyManager>     m_ResidencyManager;
+		Scope<VulkanGlobalGeometryBuffer> m_GeometryBuffer;
+
 		Ref<vk::detail::DispatchLoaderDynamic> m_DispatchLoaderDynamic;
 
 		vk::Instance m_VulkanInstance;
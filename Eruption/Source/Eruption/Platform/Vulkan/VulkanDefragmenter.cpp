@@ -0,0 +1,393 @@
+#include "VulkanDefragmenter.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+namespace Eruption
+{
+	namespace
+	{
+		constexpr vk::BufferUsageFlags BUFFER_TRANSFER_USAGE =
+		    vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst;
+		constexpr vk::ImageUsageFlags IMAGE_TRANSFER_USAGE =
+		    vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst;
+
+		vk::ImageAspectFlags GetImageAspect(vk::Format format)
+		{
+			switch (format)
+			{
+				case vk::Format::eD16Unorm:
+				case vk::Format::eX8D24UnormPack32:
+				case vk::Format::eD32Sfloat:        return vk::ImageAspectFlagBits::eDepth;
+				case vk::Format::eD16UnormS8Uint:
+				case vk::Format::eD24UnormS8Uint:
+				case vk::Format::eD32SfloatS8Uint:
+					return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+				case vk::Format::eS8Uint: return vk::ImageAspectFlagBits::eStencil;
+				default:                  return vk::ImageAspectFlagBits::eColor;
+			}
+		}
+
+		vk::ImageMemoryBarrier MakeImageBarrier(
+		    vk::Image            image,
+		    vk::ImageAspectFlags aspect,
+		    vk::ImageLayout      oldLayout,
+		    vk::ImageLayout      newLayout,
+		    vk::AccessFlags      srcAccess,
+		    vk::AccessFlags      dstAccess
+		)
+		{
+			vk::ImageMemoryBarrier barrier{};
+			barrier.srcAccessMask       = srcAccess;
+			barrier.dstAccessMask       = dstAccess;
+			barrier.oldLayout           = oldLayout;
+			barrier.newLayout           = newLayout;
+			barrier.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+			barrier.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+			barrier.image               = image;
+			barrier.subresourceRange    = {aspect, 0, vk::RemainingMipLevels, 0, vk::RemainingArrayLayers};
+			return barrier;
+		}
+
+		std::vector<vk::ImageCopy> MakeImageCopies(const vk::ImageCreateInfo& createInfo)
+		{
+			const vk::ImageAspectFlags aspect = GetImageAspect(createInfo.format);
+
+			std::vector<vk::ImageCopy> copies;
+			copies.reserve(createInfo.mipLevels);
+			for (uint32_t mip = 0; mip < createInfo.mipLevels; ++mip)
+			{
+				const vk::ImageSubresourceLayers subresource{aspect, mip, 0, createInfo.arrayLayers};
+
+				vk::Extent3D extent;
+				extent.width  = std::max(createInfo.extent.width >> mip, 1u);
+				extent.height = std::max(createInfo.extent.height >> mip, 1u);
+				extent.depth  = std::max(createInfo.extent.depth >> mip, 1u);
+
+				copies.emplace_back(subresource, vk::Offset3D{}, subresource, vk::Offset3D{}, extent);
+			}
+
+			return copies;
+		}
+
+		MetricCounter& GetBytesMovedCounter()
+		{
+			static MetricCounter& s_Counter = Metrics::GetCounter(
+			    "eruption_gpu_defragmentation_bytes_moved_total", "Bytes moved by GPU memory defragmentation"
+			);
+			return s_Counter;
+		}
+	}        // namespace
+
+	VulkanDefragmenter::VulkanDefragmenter(const Ref<VulkanDevice>& device, const Ref<VulkanAllocator>& allocator) :
+	    m_Device(device), m_Allocator(allocator)
+	{}
+
+	VulkanDefragmenter::~VulkanDefragmenter()
+	{
+		if (m_PendingFrameIndex)
+		{
+			// Only at shutdown, the copies of the last pass may still be executing
+			m_Device->GetVulkanDevice().waitIdle();
+			EndPass();
+		}
+
+		if (IsRunning())
+			Finish();
+	}
+
+	void VulkanDefragmenter::RegisterBuffer(
+	    VmaAllocation               allocation,
+	    vk::Buffer                  buffer,
+	    const vk::BufferCreateInfo& createInfo,
+	    RelocationCallback          onRelocated
+	)
+	{
+		ER_CORE_ASSERT(allocation && buffer);
+
+		if ((createInfo.usage & BUFFER_TRANSFER_USAGE) != BUFFER_TRANSFER_USAGE)
+		{
+			ER_CORE_WARN_TAG("VulkanAllocator", "Buffer without transfer usage cannot be defragmented");
+			return;
+		}
+
+		Resource& resource        = m_Resources[allocation];
+		resource.Buffer           = buffer;
+		resource.BufferCreateInfo = createInfo;
+		resource.OnRelocated      = std::move(onRelocated);
+		resource.QueueFamilyIndices.assign(
+		    createInfo.pQueueFamilyIndices, createInfo.pQueueFamilyIndices + createInfo.queueFamilyIndexCount
+		);
+		resource.BufferCreateInfo.pNext = nullptr;
+	}
+
+	void VulkanDefragmenter::RegisterImage(
+	    VmaAllocation              allocation,
+	    vk::Image                  image,
+	    const vk::ImageCreateInfo& createInfo,
+	    vk::ImageLayout            layout,
+	    RelocationCallback         onRelocated
+	)
+	{
+		ER_CORE_ASSERT(allocation && image);
+		ER_CORE_ASSERT(layout != vk::ImageLayout::eUndefined, "Moved images need a layout to be restored to!");
+
+		if ((createInfo.usage & IMAGE_TRANSFER_USAGE) != IMAGE_TRANSFER_USAGE)
+		{
+			ER_CORE_WARN_TAG("VulkanAllocator", "Image without transfer usage cannot be defragmented");
+			return;
+		}
+
+		Resource& resource       = m_Resources[allocation];
+		resource.Image           = image;
+		resource.ImageCreateInfo = createInfo;
+		resource.Layout          = layout;
+		resource.OnRelocated     = std::move(onRelocated);
+		resource.QueueFamilyIndices.assign(
+		    createInfo.pQueueFamilyIndices, createInfo.pQueueFamilyIndices + createInfo.queueFamilyIndexCount
+		);
+		resource.ImageCreateInfo.pNext         = nullptr;
+		resource.ImageCreateInfo.initialLayout = vk::ImageLayout::eUndefined;
+	}
+
+	void VulkanDefragmenter::Unregister(VmaAllocation allocation)
+	{
+		ER_CORE_ASSERT(
+		    std::ranges::find(m_PendingMoves, allocation, &PendingMove::Allocation) == m_PendingMoves.end(),
+		    "Allocation freed while it is being moved!"
+		);
+
+		m_Resources.erase(allocation);
+	}
+
+	void VulkanDefragmenter::Start(const DefragmentationSpecification& specification)
+	{
+		if (IsRunning())
+			return;
+
+		VmaDefragmentationInfo info{};
+		info.flags                 = specification.Full ? VMA_DEFRAGMENTATION_FLAG_ALGORITHM_FULL_BIT
+		                                                : VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+		info.pool                  = specification.Pool;
+		info.maxBytesPerPass       = specification.MaxBytesPerPass;
+		info.maxAllocationsPerPass = specification.MaxAllocationsPerPass;
+
+		const auto result =
+		    static_cast<vk::Result>(vmaBeginDefragmentation(m_Allocator->GetVmaAllocator(), &info, &m_Context));
+
+		if (result != vk::Result::eSuccess)
+		{
+			// Linear pools cannot be defragmented
+			ER_CORE_WARN_TAG("VulkanAllocator", "Failed to start defragmentation: {}", vk::to_string(result));
+			m_Context = VK_NULL_HANDLE;
+			return;
+		}
+
+		ER_CORE_INFO_TAG("VulkanAllocator", "Defragmentation started");
+	}
+
+	void VulkanDefragmenter::BeginFrame(VulkanCommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		if (!IsRunning())
+			return;
+
+		if (m_PendingFrameIndex)
+		{
+			// The copies of the pending pass are still on the GPU until its slot comes around again
+			if (*m_PendingFrameIndex != frameIndex)
+				return;
+
+			EndPass();
+			if (!IsRunning())
+				return;
+		}
+
+		BeginPass(commandBuffer);
+		if (IsRunning())
+			m_PendingFrameIndex = frameIndex;
+	}
+
+	void VulkanDefragmenter::BeginPass(VulkanCommandBuffer commandBuffer)
+	{
+		ER_PROFILE_FUNCTION();
+
+		const VmaAllocator allocator = m_Allocator->GetVmaAllocator();
+		const vk::Device   device    = m_Device->GetVulkanDevice();
+
+		if (vmaBeginDefragmentationPass(allocator, m_Context, &m_Pass) == VK_SUCCESS)
+		{
+			// Nothing left to move
+			Finish();
+			return;
+		}
+
+		std::vector<DefragmentationMove>    moves;
+		std::vector<vk::ImageMemoryBarrier> toTransfer;
+		std::vector<vk::ImageMemoryBarrier> toResourceLayout;
+
+		for (uint32_t i = 0; i < m_Pass.moveCount; ++i)
+		{
+			VmaDefragmentationMove& move = m_Pass.pMoves[i];
+
+			const auto it = m_Resources.find(move.srcAllocation);
+			if (it == m_Resources.end())
+			{
+				// Nobody could rebind the resource
+				move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+				continue;
+			}
+
+			Resource&            resource = it->second;
+			DefragmentationMove& moved    = moves.emplace_back();
+			moved.Allocation              = move.srcAllocation;
+
+			if (resource.Buffer)
+			{
+				vk::BufferCreateInfo createInfo = resource.BufferCreateInfo;
+				createInfo.setQueueFamilyIndices(resource.QueueFamilyIndices);
+
+				moved.OldBuffer = resource.Buffer;
+				moved.NewBuffer = device.createBuffer(createInfo);
+				VK_CHECK_RESULT(vmaBindBufferMemory(allocator, move.dstTmpAllocation, moved.NewBuffer));
+			}
+			else
+			{
+				vk::ImageCreateInfo createInfo = resource.ImageCreateInfo;
+				createInfo.setQueueFamilyIndices(resource.QueueFamilyIndices);
+
+				moved.OldImage = resource.Image;
+				moved.NewImage = device.createImage(createInfo);
+				VK_CHECK_RESULT(vmaBindImageMemory(allocator, move.dstTmpAllocation, moved.NewImage));
+
+				const vk::ImageAspectFlags aspect = GetImageAspect(createInfo.format);
+				toTransfer.push_back(MakeImageBarrier(
+				    moved.OldImage,
+				    aspect,
+				    resource.Layout,
+				    vk::ImageLayout::eTransferSrcOptimal,
+				    vk::AccessFlagBits::eMemoryWrite,
+				    vk::AccessFlagBits::eTransferRead
+				));
+				toTransfer.push_back(MakeImageBarrier(
+				    moved.NewImage,
+				    aspect,
+				    vk::ImageLayout::eUndefined,
+				    vk::ImageLayout::eTransferDstOptimal,
+				    {},
+				    vk::AccessFlagBits::eTransferWrite
+				));
+				toResourceLayout.push_back(MakeImageBarrier(
+				    moved.NewImage,
+				    aspect,
+				    vk::ImageLayout::eTransferDstOptimal,
+				    resource.Layout,
+				    vk::AccessFlagBits::eTransferWrite,
+				    vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite
+				));
+			}
+		}
+
+		if (moves.empty())
+			return;
+
+		// Earlier frames may still write the old resources, and every later command reads the new ones
+		const vk::MemoryBarrier beforeCopy{vk::AccessFlagBits::eMemoryWrite, vk::AccessFlagBits::eTransferRead};
+		const vk::MemoryBarrier afterCopy{
+		    vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite
+		};
+
+		commandBuffer.PipelineBarrier(
+		    vk::PipelineStageFlagBits::eAllCommands,
+		    vk::PipelineStageFlagBits::eTransfer,
+		    {},
+		    beforeCopy,
+		    {},
+		    toTransfer
+		);
+
+		uint64_t bytesMoved = 0;
+		for (const DefragmentationMove& moved : moves)
+		{
+			const Resource& resource = m_Resources.at(moved.Allocation);
+			if (moved.NewBuffer)
+			{
+				const vk::BufferCopy region{0, 0, resource.BufferCreateInfo.size};
+				commandBuffer.Get().copyBuffer(moved.OldBuffer, moved.NewBuffer, region);
+			}
+			else
+			{
+				commandBuffer.Get().copyImage(
+				    moved.OldImage,
+				    vk::ImageLayout::eTransferSrcOptimal,
+				    moved.NewImage,
+				    vk::ImageLayout::eTransferDstOptimal,
+				    MakeImageCopies(resource.ImageCreateInfo)
+				);
+			}
+
+			bytesMoved += m_Allocator->GetAllocationInfo(moved.Allocation).Size;
+		}
+
+		commandBuffer.PipelineBarrier(
+		    vk::PipelineStageFlagBits::eTransfer,
+		    vk::PipelineStageFlagBits::eAllCommands,
+		    {},
+		    afterCopy,
+		    {},
+		    toResourceLayout
+		);
+
+		for (const DefragmentationMove& moved : moves)
+		{
+			Resource& resource = m_Resources.at(moved.Allocation);
+			resource.Buffer    = moved.NewBuffer ? moved.NewBuffer : resource.Buffer;
+			resource.Image     = moved.NewImage ? moved.NewImage : resource.Image;
+
+			m_PendingMoves.push_back(
+			    {.Allocation = moved.Allocation, .OldBuffer = moved.OldBuffer, .OldImage = moved.OldImage}
+			);
+
+			if (resource.OnRelocated)
+				resource.OnRelocated(moved);
+		}
+
+		GetBytesMovedCounter().Increment(bytesMoved);
+	}
+
+	void VulkanDefragmenter::EndPass()
+	{
+		ER_PROFILE_FUNCTION();
+
+		const vk::Device device = m_Device->GetVulkanDevice();
+		for (const PendingMove& move : m_PendingMoves)
+		{
+			if (move.OldBuffer)
+				device.destroyBuffer(move.OldBuffer);
+			if (move.OldImage)
+				device.destroyImage(move.OldImage);
+		}
+
+		m_PendingMoves.clear();
+		m_PendingFrameIndex.reset();
+
+		// Frees the old memory, the moved allocations now point at their new place
+		if (vmaEndDefragmentationPass(m_Allocator->GetVmaAllocator(), m_Context, &m_Pass) == VK_SUCCESS)
+			Finish();
+	}
+
+	void VulkanDefragmenter::Finish()
+	{
+		VmaDefragmentationStats stats{};
+		vmaEndDefragmentation(m_Allocator->GetVmaAllocator(), m_Context, &stats);
+		m_Context = VK_NULL_HANDLE;
+		m_Pass    = {};
+
+		ER_CORE_INFO_TAG(
+		    "VulkanAllocator",
+		    "Defragmentation moved {} allocations ({} bytes) and freed {} blocks ({} bytes)",
+		    stats.allocationsMoved,
+		    stats.bytesMoved,
+		    stats.deviceMemoryBlocksFreed,
+		    stats.bytesFreed
+		);
+	}
+}        // namespace Eruption
@@ -0,0 +1,117 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+#include "Eruption/Platform/Vulkan/VulkanCommandBuffer.h"
+
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Eruption
+{
+	struct DefragmentationSpecification
+	{
+		VmaPool        Pool                  = VK_NULL_HANDLE;        // Default pools when null
+		bool           Full                  = false;                 // Slower, but packs allocations tightly
+		vk::DeviceSize MaxBytesPerPass       = 16ull * 1024 * 1024;
+		uint32_t       MaxAllocationsPerPass = 64;
+	};
+
+	// Passed to the relocation callback once the copy into the new resource has been recorded. The allocation
+	// handle stays the same; descriptors and views of the old resource must be rewritten to the new one before
+	// anything else is recorded, the old resource is destroyed once the frame that copied it has completed.
+	struct DefragmentationMove
+	{
+		VmaAllocation Allocation = VK_NULL_HANDLE;
+		vk::Buffer    OldBuffer;
+		vk::Buffer    NewBuffer;
+		vk::Image     OldImage;
+		vk::Image     NewImage;
+	};
+
+	using RelocationCallback = std::function<void(const DefragmentationMove&)>;
+
+	// Incremental defragmentation on top of VulkanAllocator. Only registered allocations are moved: the
+	// defragmenter recreates their resource in the new place, records the GPU copy into the frame's command
+	// buffer and reports the new handle through the relocation callback. One pass is in flight at a time and
+	// it is committed when its frame slot comes around again, so nothing waits on the GPU and each pass moves
+	// at most MaxBytesPerPass and MaxAllocationsPerPass.
+	//
+	// Not thread-safe, use it from the render thread.
+	class VulkanDefragmenter
+	{
+	public:
+		VulkanDefragmenter(const Ref<VulkanDevice>& device, const Ref<VulkanAllocator>& allocator);
+		~VulkanDefragmenter();
+
+		VulkanDefragmenter(const VulkanDefragmenter&)            = delete;
+		VulkanDefragmenter& operator=(const VulkanDefragmenter&) = delete;
+		VulkanDefragmenter(VulkanDefragmenter&&)                 = delete;
+		VulkanDefragmenter& operator=(VulkanDefragmenter&&)      = delete;
+
+		// The buffer needs eTransferSrc and eTransferDst usage to be movable
+		void RegisterBuffer(
+		    VmaAllocation               allocation,
+		    vk::Buffer                  buffer,
+		    const vk::BufferCreateInfo& createInfo,
+		    RelocationCallback          onRelocated
+		);
+
+		// The image needs eTransferSrc and eTransferDst usage and must be in layout between frames
+		void RegisterImage(
+		    VmaAllocation              allocation,
+		    vk::Image                  image,
+		    const vk::ImageCreateInfo& createInfo,
+		    vk::ImageLayout            layout,
+		    RelocationCallback         onRelocated
+		);
+
+		// Must be called before the allocation is freed
+		void Unregister(VmaAllocation allocation);
+
+		// Starts a defragmentation that runs over the following frames, ignored while one is running
+		void Start(const DefragmentationSpecification& specification = {});
+		[[nodiscard]] bool IsRunning() const { return m_Context != VK_NULL_HANDLE; }
+
+		// Commits the pass recorded in this slot FramesInFlight frames ago, then records the next pass. Must be
+		// recorded before anything else in the frame, after the fence of the frame previously using the slot
+		// has been waited on.
+		void BeginFrame(VulkanCommandBuffer commandBuffer, uint32_t frameIndex);
+
+	private:
+		struct Resource
+		{
+			vk::Buffer            Buffer;
+			vk::BufferCreateInfo  BufferCreateInfo;
+			vk::Image             Image;
+			vk::ImageCreateInfo   ImageCreateInfo;
+			vk::ImageLayout       Layout = vk::ImageLayout::eUndefined;
+			std::vector<uint32_t> QueueFamilyIndices;        // Copied, the create info must not point at the caller's
+			RelocationCallback    OnRelocated;
+		};
+
+		struct PendingMove
+		{
+			VmaAllocation Allocation;
+			vk::Buffer    OldBuffer;
+			vk::Image     OldImage;
+		};
+
+		void BeginPass(VulkanCommandBuffer commandBuffer);
+		void EndPass();
+		void Finish();
+
+	private:
+		Ref<VulkanDevice>    m_Device;
+		Ref<VulkanAllocator> m_Allocator;
+
+		std::unordered_map<VmaAllocation, Resource> m_Resources;
+
+		VmaDefragmentationContext      m_Context = VK_NULL_HANDLE;
+		VmaDefragmentationPassMoveInfo m_Pass{};
+		std::vector<PendingMove>       m_PendingMoves;
+		std::optional<uint32_t>        m_PendingFrameIndex;
+	};
+}        // namespace Eruption
@@ -0,0 +1,149 @@
+#include "VulkanDeletionQueue.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+#include <type_traits>
+
+namespace Eruption
+{
+	namespace
+	{
+		MetricCounter& GetDeletionCounter()
+		{
+			static MetricCounter& s_Counter = Metrics::GetCounter(
+			    "eruption_deferred_deletions_total", "GPU objects destroyed through the deletion queue"
+			);
+			return s_Counter;
+		}
+	}        // namespace
+
+	VulkanDeletionQueue::VulkanDeletionQueue(
+	    const Ref<VulkanDevice>& device, const Ref<VulkanAllocator>& allocator, uint32_t framesInFlight
+	) :
+	    m_Device(device), m_Allocator(allocator), m_Frames(framesInFlight)
+	{
+		ER_CORE_ASSERT(framesInFlight > 0);
+	}
+
+	VulkanDeletionQueue::~VulkanDeletionQueue()
+	{
+		Flush();
+	}
+
+	void VulkanDeletionQueue::DestroyBuffer(vk::Buffer buffer, VmaAllocation allocation)
+	{
+		Push(BufferDeletion{buffer, allocation});
+	}
+
+	void VulkanDeletionQueue::DestroyImage(vk::Image image, VmaAllocation allocation)
+	{
+		Push(ImageDeletion{image, allocation});
+	}
+
+	void VulkanDeletionQueue::DestroyImageView(vk::ImageView imageView)
+	{
+		Push(imageView);
+	}
+
+	void VulkanDeletionQueue::DestroySampler(vk::Sampler sampler)
+	{
+		Push(sampler);
+	}
+
+	void VulkanDeletionQueue::DestroyPipeline(vk::Pipeline pipeline)
+	{
+		Push(pipeline);
+	}
+
+	void VulkanDeletionQueue::DestroySwapchain(vk::SwapchainKHR swapchain)
+	{
+		Push(swapchain);
+	}
+
+	void VulkanDeletionQueue::Enqueue(std::function<void()> deleter)
+	{
+		Push(std::move(deleter));
+	}
+
+	void VulkanDeletionQueue::BeginFrame(uint32_t frameIndex)
+	{
+		ER_PROFILE_FUNCTION();
+		ER_CORE_ASSERT(frameIndex < m_Frames.size(), "Frame index out of range!");
+
+		// Destroyed outside the lock, so releases from other threads are not held up by the driver
+		std::vector<Deletion> deletions;
+		{
+			std::lock_guard lock(m_Mutex);
+			deletions.swap(m_Frames[frameIndex]);
+			m_CurrentFrame = frameIndex;
+		}
+
+		Execute(deletions);
+	}
+
+	void VulkanDeletionQueue::Flush()
+	{
+		std::vector<std::vector<Deletion>> frames(m_Frames.size());
+		{
+			std::lock_guard lock(m_Mutex);
+			frames.swap(m_Frames);
+		}
+
+		// Oldest slot first, the current one was released last
+		for (uint32_t i = 1; i <= frames.size(); ++i)
+			Execute(frames[(m_CurrentFrame + i) % frames.size()]);
+	}
+
+	size_t VulkanDeletionQueue::GetPendingCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		size_t count = 0;
+		for (const std::vector<Deletion>& deletions : m_Frames)
+			count += deletions.size();
+
+		return count;
+	}
+
+	void VulkanDeletionQueue::Push(Deletion&& deletion)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Frames[m_CurrentFrame].push_back(std::move(deletion));
+	}
+
+	void VulkanDeletionQueue::Execute(std::vector<Deletion>& deletions) const
+	{
+		if (deletions.empty())
+			return;
+
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		// Destroyed in release order, views are usually released before the image they were created from
+		for (Deletion& deletion : deletions)
+		{
+			std::visit(
+			    [&]<typename T>(T& object)
+			    {
+				    if constexpr (std::is_same_v<T, BufferDeletion>)
+					    m_Allocator->DestroyBuffer(object.Buffer, object.Allocation);
+				    else if constexpr (std::is_same_v<T, ImageDeletion>)
+					    m_Allocator->DestroyImage(object.Image, object.Allocation);
+				    else if constexpr (std::is_same_v<T, vk::ImageView>)
+					    vulkanDevice.destroyImageView(object);
+				    else if constexpr (std::is_same_v<T, vk::Sampler>)
+					    vulkanDevice.destroySampler(object);
+				    else if constexpr (std::is_same_v<T, vk::Pipeline>)
+					    vulkanDevice.destroyPipeline(object);
+				    else if constexpr (std::is_same_v<T, vk::SwapchainKHR>)
+					    vulkanDevice.destroySwapchainKHR(object);
+				    else
+					    object();
+			    },
+			    deletion
+			);
+		}
+
+		GetDeletionCounter().Increment(deletions.size());
+		deletions.clear();
+	}
+}        // namespace Eruption
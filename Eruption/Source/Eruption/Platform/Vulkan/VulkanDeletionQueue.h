@@ -0,0 +1,87 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+
+#include <functional>
+#include <mutex>
+#include <variant>
+#include <vector>
+
+namespace Eruption
+{
+	// Defers the destruction of GPU objects until the frames that may still use them have completed. Objects
+	// released while a frame slot is current are destroyed the next time BeginFrame is called for that slot,
+	// which by then has waited on the slot's fence, so neither resize nor streaming has to wait for the device
+	// to go idle:
+	//
+	//     deletionQueue.DestroyBuffer(m_Buffer, m_Allocation);        // Still bound in the frame being recorded
+	//
+	// Release functions are safe to call from several threads, BeginFrame and Flush are not.
+	class VulkanDeletionQueue
+	{
+	public:
+		VulkanDeletionQueue(
+		    const Ref<VulkanDevice>& device, const Ref<VulkanAllocator>& allocator, uint32_t framesInFlight
+		);
+		~VulkanDeletionQueue();
+
+		VulkanDeletionQueue(const VulkanDeletionQueue&)            = delete;
+		VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+		VulkanDeletionQueue(VulkanDeletionQueue&&)                 = delete;
+		VulkanDeletionQueue& operator=(VulkanDeletionQueue&&)      = delete;
+
+		void DestroyBuffer(vk::Buffer buffer, VmaAllocation allocation);
+		void DestroyImage(vk::Image image, VmaAllocation allocation);
+		void DestroyImageView(vk::ImageView imageView);
+		void DestroySampler(vk::Sampler sampler);
+		void DestroyPipeline(vk::Pipeline pipeline);
+		void DestroySwapchain(vk::SwapchainKHR swapchain);
+
+		// For anything else, the function runs on the render thread
+		void Enqueue(std::function<void()> deleter);
+
+		// Destroys what was released the last time this slot was current, called by VulkanContext::BeginFrame
+		// with Application::GetCurrentFrameIndex(). Must be called after the fence of the frame previously using
+		// the slot has been waited on.
+		void BeginFrame(uint32_t frameIndex);
+
+		// Destroys everything that is pending, the device must be idle
+		void Flush();
+
+		[[nodiscard]] size_t GetPendingCount() const;
+
+	private:
+		struct BufferDeletion
+		{
+			vk::Buffer    Buffer;
+			VmaAllocation Allocation;
+		};
+
+		struct ImageDeletion
+		{
+			vk::Image     Image;
+			VmaAllocation Allocation;
+		};
+
+		using Deletion = std::variant<
+		    BufferDeletion,
+		    ImageDeletion,
+		    vk::ImageView,
+		    vk::Sampler,
+		    vk::Pipeline,
+		    vk::SwapchainKHR,
+		    std::function<void()>>;
+
+		void Push(Deletion&& deletion);
+		void Execute(std::vector<Deletion>& deletions) const;
+
+	private:
+		Ref<VulkanDevice>    m_Device;
+		Ref<VulkanAllocator> m_Allocator;
+
+		mutable std::mutex                 m_Mutex;
+		std::vector<std::vector<Deletion>> m_Frames;        // One list per frame in flight
+		uint32_t                           m_CurrentFrame = 0;
+	};
+}        // namespace Eruption
@@ -1,5 +1,6 @@
 #include "VulkanDevice.h"
 
+#include "Eruption/Platform/Vulkan/VulkanCallCounters.h"
 #include "Eruption/Platform/Vulkan/VulkanContext.h"
 
 namespace Eruption
@@ -352,6 +353,7 @@ namespace Eruption
 		);
 
 		const vk::CommandBuffer commandBuffer = vulkanDevice.allocateCommandBuffers(commandBufferAllocateInfo).front();
+		VulkanCallCounters::Increment(VulkanCall::CommandBufferAllocate);
 
 		if (begin)
 			commandBuffer.begin(vk::CommandBufferBeginInfo{});
@@ -422,28 +424,32 @@ namespace Eruption
 
 	void VulkanDevice::LockQueue(QueueType queueType)
 	{
-		switch (queueType)
-		{
-			case QueueType::Present:  [[fallthrough]];
-			case QueueType::Graphics: m_GraphicsQueueMutex.lock(); return;
-			case QueueType::Compute:  m_ComputeQueueMutex.lock(); return;
-			case QueueType::Transfer: m_TransferQueueMutex.lock(); return;
-		}
+		std::mutex& mutex = GetQueueMutex(queueType);
+		if (mutex.try_lock())
+			return;
 
-		ER_CORE_ASSERT(false, "Invalid queue type!");
+		VulkanCallCounters::Increment(VulkanCall::QueueLockWait);
+		mutex.lock();
 	}
 
 	void VulkanDevice::UnlockQueue(QueueType queueType)
 	{
-		switch (queueType)
-		{
-			case QueueType::Present:  [[fallthrough]];
-			case QueueType::Graphics: m_GraphicsQueueMutex.unlock(); return;
-			case QueueType::Compute:  m_ComputeQueueMutex.unlock(); return;
-			case QueueType::Transfer: m_TransferQueueMutex.unlock(); return;
-		}
+		GetQueueMutex(queueType).unlock();
+	}
 
-		ER_CORE_ASSERT(false, "Invalid queue type!");
+	void VulkanDevice::Submit(QueueType queueType, const vk::SubmitInfo& submitInfo, vk::Fence fence)
+	{
+		LockQueue(queueType);
+		GetQueue(queueType).submit(submitInfo, fence);
+		UnlockQueue(queueType);
+
+		VulkanCallCounters::Increment(VulkanCall::QueueSubmit);
+	}
+
+	vk::Fence VulkanDevice::CreateFence(vk::FenceCreateFlags flags) const
+	{
+		VulkanCallCounters::Increment(VulkanCall::FenceCreate);
+		return m_LogicalDevice.createFence(vk::FenceCreateInfo(flags));
 	}
 
 	vk::CommandBuffer VulkanDevice::BeginSingleTimeCommands(QueueType queueType)
@@ -461,13 +467,8 @@ namespace Eruption
 		vk::SubmitInfo submitInfo{};
 		submitInfo.setCommandBuffers(commandBuffer);
 
-		const vk::Fence commandBufferFinishedFence = vulkanDevice.createFence(vk::FenceCreateInfo{});
-
-		{
-			LockQueue();
-			GetQueue(queueType).submit(submitInfo, commandBufferFinishedFence);
-			UnlockQueue();
-		}
+		const vk::Fence commandBufferFinishedFence = CreateFence();
+		Submit(queueType, submitInfo, commandBufferFinishedFence);
 
 		VK_CHECK_RESULT(
 		    vulkanDevice.waitForFences(commandBufferFinishedFence, vk::True, std::numeric_limits<uint64_t>::max())
@@ -491,6 +492,19 @@ namespace Eruption
 		return VK_NULL_HANDLE;
 	}
 
+	std::mutex& VulkanDevice::GetQueueMutex(QueueType queueType)
+	{
+		// Compute and transfer fall back to the graphics family when the device has no dedicated one, queue types
+		// sharing a vk::Queue must also share its mutex
+		const vk::Queue queue = GetQueue(queueType);
+		if (queue == m_GraphicsQueue)
+			return m_GraphicsQueueMutex;
+		if (queue == m_ComputeQueue)
+			return m_ComputeQueueMutex;
+
+		return m_TransferQueueMutex;
+	}
+
 	Ref<VulkanCommandPool> VulkanDevice::GetThreadLocalCommandPool()
 	{
 		const auto threadID = std::this_thread::get_id();
@@ -217,6 +217,11 @@ namespace Eruption
 		void LockQueue(QueueType queueType = QueueType::Graphics);
 		void UnlockQueue(QueueType queueType = QueueType::Graphics);
 
+		// Locks the queue around the submission
+		void Submit(QueueType queueType, const vk::SubmitInfo& submitInfo, vk::Fence fence = VK_NULL_HANDLE);
+
+		[[nodiscard]] vk::Fence CreateFence(vk::FenceCreateFlags flags = {}) const;
+
 		[[nodiscard]] vk::CommandBuffer BeginSingleTimeCommands(QueueType queueType = QueueType::Graphics);
 		void EndSingleTimeCommands(vk::CommandBuffer commandBuffer, QueueType queueType = QueueType::Graphics);
 
@@ -229,6 +234,7 @@ namespace Eruption
 	private:
 		[[nodiscard]] Ref<VulkanCommandPool> GetThreadLocalCommandPool();
 		[[nodiscard]] Ref<VulkanCommandPool> GetOrCreateThreadLocalCommandPool();
+		[[nodiscard]] std::mutex&            GetQueueMutex(QueueType queueType);
 
 	private:
 		std::map<std::thread::id, Ref<VulkanCommandPool>> m_CommandPools;
@@ -0,0 +1,85 @@
+#include "VulkanFrameDataAllocator.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+namespace Eruption
+{
+	namespace
+	{
+		// Index data needs 4, 16 also keeps vec4 vertex attributes aligned
+		constexpr vk::DeviceSize VERTEX_ALIGNMENT = 16;
+
+		MetricCounter& GetAllocatedBytesCounter()
+		{
+			static MetricCounter& s_Counter = Metrics::GetPerFrameCounter(
+			    "eruption_frame_data_bytes_total", "Bytes allocated from the per-frame data buffer"
+			);
+			return s_Counter;
+		}
+
+		MetricCounter& GetOverflowCounter()
+		{
+			static MetricCounter& s_Counter = Metrics::GetCounter(
+			    "eruption_frame_data_overflows_total", "Frame data allocations that did not fit the frame's region"
+			);
+			return s_Counter;
+		}
+	}        // namespace
+
+	VulkanFrameDataAllocator::VulkanFrameDataAllocator(
+	    const Ref<VulkanDevice>&    device,
+	    const Ref<VulkanAllocator>& allocator,
+	    uint32_t                    framesInFlight,
+	    vk::DeviceSize              frameCapacity
+	) :
+	    m_Ring(
+	        allocator,
+	        vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+	            vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer,
+	        MemoryUsage::AutoPreferDevice,
+	        framesInFlight,
+	        frameCapacity,
+	        "FrameData",
+	        GetAllocatedBytesCounter(),
+	        GetOverflowCounter()
+	    )
+	{
+		const vk::PhysicalDeviceLimits& limits = device->GetPhysicalDevice()->GetProperties().properties.limits;
+		m_UniformAlignment                     = limits.minUniformBufferOffsetAlignment;
+		m_StorageAlignment                     = limits.minStorageBufferOffsetAlignment;
+	}
+
+	std::optional<FrameDataAllocation> VulkanFrameDataAllocator::Allocate(vk::DeviceSize size, FrameDataUsage usage)
+	{
+		const std::optional<FrameRingAllocation> allocation = m_Ring.Allocate(size, GetAlignment(usage));
+		if (!allocation)
+		{
+			ER_CORE_WARN_TAG_ONCE(
+			    "Renderer",
+			    "Frame data buffer is full ({0} bytes per frame), raise FrameDataBufferSize",
+			    GetFrameCapacity()
+			);
+			return std::nullopt;
+		}
+
+		return FrameDataAllocation{
+		    .Buffer = m_Ring.GetBuffer(),
+		    .Offset = allocation->Offset,
+		    .Size   = size,
+		    .Data   = allocation->Data
+		};
+	}
+
+	vk::DeviceSize VulkanFrameDataAllocator::GetAlignment(FrameDataUsage usage) const
+	{
+		switch (usage)
+		{
+			case FrameDataUsage::Uniform: return m_UniformAlignment;
+			case FrameDataUsage::Storage: return m_StorageAlignment;
+			case FrameDataUsage::Vertex:
+			case FrameDataUsage::Index:   return VERTEX_ALIGNMENT;
+		}
+		ER_CORE_ASSERT(false, "Invalid frame data usage");
+		return VERTEX_ALIGNMENT;
+	}
+}        // namespace Eruption
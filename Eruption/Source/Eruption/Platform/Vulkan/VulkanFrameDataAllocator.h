@@ -0,0 +1,101 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanFrameRing.h"
+
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace Eruption
+{
+	enum class FrameDataUsage : uint8_t
+	{
+		Uniform,        // Aligned to minUniformBufferOffsetAlignment
+		Storage,        // Aligned to minStorageBufferOffsetAlignment
+		Vertex,
+		Index
+	};
+
+	// Per-frame data handed out by VulkanFrameDataAllocator, valid until the end of the frame it was allocated in
+	struct FrameDataAllocation
+	{
+		vk::Buffer     Buffer;
+		vk::DeviceSize Offset = 0;
+		vk::DeviceSize Size   = 0;
+		void*          Data   = nullptr;        // Persistently mapped, write the data here
+
+		// For descriptors of type eUniformBufferDynamic/eStorageBufferDynamic written with offset 0
+		[[nodiscard]] uint32_t GetDynamicOffset() const { return static_cast<uint32_t>(Offset); }
+
+		template <typename T>
+		[[nodiscard]] T* As() const
+		{
+			return static_cast<T*>(Data);
+		}
+	};
+
+	// Transient per-draw constants and dynamic vertex data. Suballocates aligned chunks from one persistently
+	// mapped buffer, device local when the device has host-visible device memory and host memory otherwise,
+	// split into one region per frame in flight. A region is reused once the fence of the frame that filled
+	// it has signaled, so nothing is created or mapped per draw.
+	//
+	// Bind GetBuffer() once through a dynamic descriptor with GetDescriptorInfo(), then pass the dynamic offset
+	// of every allocation when binding the set:
+	//
+	//     if (const auto constants = frameData.Push(drawConstants, FrameDataUsage::Uniform))
+	//         commandBuffer.BindDescriptorSets(bindPoint, layout, 0, set, constants->GetDynamicOffset());
+	//
+	// Allocate is safe to call from several threads, BeginFrame and EndFrame are not.
+	class VulkanFrameDataAllocator
+	{
+	public:
+		VulkanFrameDataAllocator(
+		    const Ref<VulkanDevice>&    device,
+		    const Ref<VulkanAllocator>& allocator,
+		    uint32_t                    framesInFlight,
+		    vk::DeviceSize              frameCapacity
+		);
+
+		VulkanFrameDataAllocator(const VulkanFrameDataAllocator&)            = delete;
+		VulkanFrameDataAllocator& operator=(const VulkanFrameDataAllocator&) = delete;
+		VulkanFrameDataAllocator(VulkanFrameDataAllocator&&)                 = delete;
+		VulkanFrameDataAllocator& operator=(VulkanFrameDataAllocator&&)      = delete;
+
+		// frameIndex is usually Application::GetCurrentFrameIndex(), see VulkanFrameRing::BeginFrame and
+		// VulkanFrameRing::EndFrame
+		void BeginFrame(uint32_t frameIndex) { m_Ring.BeginFrame(frameIndex); }
+		void EndFrame() { m_Ring.EndFrame(); }
+
+		// Returns nullopt when the frame's region is full
+		[[nodiscard]] std::optional<FrameDataAllocation> Allocate(vk::DeviceSize size, FrameDataUsage usage);
+
+		template <typename T>
+		    requires std::is_trivially_copyable_v<T>
+		[[nodiscard]] std::optional<FrameDataAllocation> Push(const T& data, FrameDataUsage usage)
+		{
+			std::optional<FrameDataAllocation> allocation = Allocate(sizeof(T), usage);
+			if (allocation)
+				std::memcpy(allocation->Data, &data, sizeof(T));
+
+			return allocation;
+		}
+
+		// Range is the largest allocation read through the descriptor, e.g. sizeof the per-draw constants
+		[[nodiscard]] vk::DescriptorBufferInfo GetDescriptorInfo(vk::DeviceSize range) const
+		{
+			return {m_Ring.GetBuffer(), 0, range};
+		}
+
+		[[nodiscard]] vk::Buffer     GetBuffer() const { return m_Ring.GetBuffer(); }
+		[[nodiscard]] vk::DeviceSize GetAlignment(FrameDataUsage usage) const;
+		[[nodiscard]] vk::DeviceSize GetFrameCapacity() const { return m_Ring.GetFrameCapacity(); }
+		[[nodiscard]] vk::DeviceSize GetFrameUsage() const { return m_Ring.GetFrameUsage(); }
+
+	private:
+		VulkanFrameRing m_Ring;
+
+		vk::DeviceSize m_UniformAlignment = 0;
+		vk::DeviceSize m_StorageAlignment = 0;
+	};
+}        // namespace Eruption
@@ -0,0 +1,91 @@
+#include "VulkanFrameRing.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+namespace Eruption
+{
+	VulkanFrameRing::VulkanFrameRing(
+	    const Ref<VulkanAllocator>& allocator,
+	    vk::BufferUsageFlags        bufferUsage,
+	    MemoryUsage                 memoryUsage,
+	    uint32_t                    framesInFlight,
+	    vk::DeviceSize              frameCapacity,
+	    std::string_view            name,
+	    MetricCounter&              bytesCounter,
+	    MetricCounter&              overflowCounter
+	) :
+	    m_Allocator(allocator),
+	    m_BytesCounter(bytesCounter),
+	    m_OverflowCounter(overflowCounter),
+	    m_FrameCapacity(frameCapacity),
+	    m_FramesInFlight(framesInFlight)
+	{
+		ER_CORE_ASSERT(framesInFlight > 0 && frameCapacity > 0);
+
+		vk::BufferCreateInfo bufferCreateInfo{};
+		bufferCreateInfo.size        = frameCapacity * framesInFlight;
+		bufferCreateInfo.usage       = bufferUsage;
+		bufferCreateInfo.sharingMode = vk::SharingMode::eExclusive;
+
+		// Sequential writes let VMA pick host-visible device memory (ReBAR, integrated GPUs) when there is any
+		AllocationCreateFlags flags = AllocationCreateFlagBits::Mapped;
+		flags |= AllocationCreateFlagBits::HostAccessSequentialWrite;
+
+		auto allocation = m_Allocator->AllocateBuffer(bufferCreateInfo, memoryUsage, m_Buffer, flags);
+		ER_CORE_VERIFY(allocation, "Failed to allocate the {0} buffer!", name);
+
+		m_Allocation = *allocation;
+		m_Allocator->SetAllocationName(m_Allocation, name);
+		m_MappedData = static_cast<std::byte*>(m_Allocator->GetAllocationInfo(m_Allocation).MappedData);
+	}
+
+	VulkanFrameRing::~VulkanFrameRing()
+	{
+		if (m_Allocation)
+			m_Allocator->DestroyBuffer(m_Buffer, m_Allocation);
+	}
+
+	void VulkanFrameRing::BeginFrame(uint32_t frameIndex)
+	{
+		ER_CORE_ASSERT(frameIndex < m_FramesInFlight, "Frame index out of range!");
+
+		m_FrameBase = frameIndex * m_FrameCapacity;
+		m_FrameOffset.store(0, std::memory_order_relaxed);
+	}
+
+	void VulkanFrameRing::EndFrame()
+	{
+		const vk::DeviceSize used = m_FrameOffset.load(std::memory_order_acquire);
+		if (used == 0)
+			return;
+
+		// Dropped on host-coherent memory
+		m_Allocator->QueueFlush(m_Allocation, m_FrameBase, used);
+		m_BytesCounter.Increment(used);
+	}
+
+	std::optional<FrameRingAllocation> VulkanFrameRing::Allocate(vk::DeviceSize size, vk::DeviceSize alignment)
+	{
+		ER_CORE_ASSERT(alignment > 0);
+
+		vk::DeviceSize offset = m_FrameOffset.load(std::memory_order_relaxed);
+		vk::DeviceSize alignedOffset;
+		do
+		{
+			// Aligned relative to the whole buffer, as copy, dynamic and bind offsets are
+			const vk::DeviceSize absolute = m_FrameBase + offset;
+			alignedOffset                 = (absolute + alignment - 1) / alignment * alignment - m_FrameBase;
+
+			if (alignedOffset + size > m_FrameCapacity)
+			{
+				m_OverflowCounter.Increment();
+				return std::nullopt;
+			}
+		} while (!m_FrameOffset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_acq_rel));
+
+		return FrameRingAllocation{
+		    .Offset = m_FrameBase + alignedOffset,
+		    .Data   = m_MappedData + m_FrameBase + alignedOffset
+		};
+	}
+}        // namespace Eruption
@@ -0,0 +1,78 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+
+#include <atomic>
+#include <optional>
+#include <string_view>
+
+namespace Eruption
+{
+	class MetricCounter;
+
+	// Range handed out by VulkanFrameRing::Allocate
+	struct FrameRingAllocation
+	{
+		vk::DeviceSize Offset = 0;              // Absolute, from the start of the buffer
+		std::byte*     Data   = nullptr;        // Persistently mapped
+	};
+
+	// One persistently mapped buffer split into one region per frame in flight, bump-allocated from the current
+	// frame's region. The region is reused once the fence of the frame that filled it has signaled. Backs
+	// VulkanStagingRing and VulkanFrameDataAllocator, which decide the usage, memory and alignment.
+	//
+	// Allocate is safe to call from several threads, BeginFrame and EndFrame are not.
+	class VulkanFrameRing
+	{
+	public:
+		// bytesCounter receives the bytes used each frame, overflowCounter every allocation that did not fit
+		VulkanFrameRing(
+		    const Ref<VulkanAllocator>& allocator,
+		    vk::BufferUsageFlags        bufferUsage,
+		    MemoryUsage                 memoryUsage,
+		    uint32_t                    framesInFlight,
+		    vk::DeviceSize              frameCapacity,
+		    std::string_view            name,
+		    MetricCounter&              bytesCounter,
+		    MetricCounter&              overflowCounter
+		);
+		~VulkanFrameRing();
+
+		VulkanFrameRing(const VulkanFrameRing&)            = delete;
+		VulkanFrameRing& operator=(const VulkanFrameRing&) = delete;
+		VulkanFrameRing(VulkanFrameRing&&)                 = delete;
+		VulkanFrameRing& operator=(VulkanFrameRing&&)      = delete;
+
+		// Reclaims the region of this slot. Must be called after the fence of the frame previously using the
+		// slot has been waited on.
+		void BeginFrame(uint32_t frameIndex);
+
+		// Queues the flush of the bytes written this frame, which VulkanContext::EndFrame then flushes with
+		// VulkanAllocator::FlushMappedRanges before the frame's command buffers are submitted
+		void EndFrame();
+
+		// Returns nullopt when the frame's region is full. The offset is aligned relative to the start of the
+		// buffer, so alignment does not have to be a power of two.
+		[[nodiscard]] std::optional<FrameRingAllocation> Allocate(vk::DeviceSize size, vk::DeviceSize alignment);
+
+		[[nodiscard]] vk::Buffer     GetBuffer() const { return m_Buffer; }
+		[[nodiscard]] vk::DeviceSize GetFrameCapacity() const { return m_FrameCapacity; }
+		[[nodiscard]] vk::DeviceSize GetFrameUsage() const { return m_FrameOffset.load(std::memory_order_relaxed); }
+
+	private:
+		Ref<VulkanAllocator> m_Allocator;
+		MetricCounter&       m_BytesCounter;
+		MetricCounter&       m_OverflowCounter;
+
+		vk::Buffer     m_Buffer;
+		VmaAllocation  m_Allocation     = VK_NULL_HANDLE;
+		std::byte*     m_MappedData     = nullptr;
+		vk::DeviceSize m_FrameCapacity  = 0;
+		uint32_t       m_FramesInFlight = 0;
+
+		// Start of the current frame's region and the bytes allocated from it
+		vk::DeviceSize              m_FrameBase   = 0;
+		std::atomic<vk::DeviceSize> m_FrameOffset = 0;
+	};
+}        // namespace Eruption
@@ -0,0 +1,219 @@
+#include "VulkanGlobalGeometryBuffer.h"
+
+#include <bit>
+
+namespace Eruption
+{
+	namespace
+	{
+		uint32_t GetIndexSize(vk::IndexType indexType)
+		{
+			switch (indexType)
+			{
+				case vk::IndexType::eUint16: return 2;
+				case vk::IndexType::eUint32: return 4;
+				default:                     break;
+			}
+			ER_CORE_ASSERT(false, "Unsupported index type");
+			return 4;
+		}
+	}        // namespace
+
+	VulkanGlobalGeometryBuffer::VulkanGlobalGeometryBuffer(
+	    const Ref<VulkanAllocator>& allocator, vk::DeviceSize vertexPageSize, vk::DeviceSize indexPageSize
+	) :
+	    m_Allocator(allocator), m_VertexPageSize(vertexPageSize), m_IndexPageSize(indexPageSize)
+	{
+		ER_CORE_ASSERT(vertexPageSize > 0 && indexPageSize > 0);
+	}
+
+	VulkanGlobalGeometryBuffer::~VulkanGlobalGeometryBuffer()
+	{
+		for (std::vector<Page>* pages : {&m_VertexPages, &m_IndexPages})
+		{
+			for (const Page& page : *pages)
+			{
+				if (vmaIsVirtualBlockEmpty(page.VirtualBlock) == VK_FALSE)
+				{
+					ER_CORE_WARN_TAG("Renderer", "Geometry ranges were not freed before the geometry buffer");
+					vmaClearVirtualBlock(page.VirtualBlock);
+				}
+
+				vmaDestroyVirtualBlock(page.VirtualBlock);
+				m_Allocator->DestroyBuffer(page.Buffer, page.Allocation);
+			}
+		}
+	}
+
+	std::optional<GeometryRange> VulkanGlobalGeometryBuffer::AllocateVertices(uint32_t vertexCount, uint32_t stride)
+	{
+		ER_CORE_ASSERT(vertexCount > 0 && stride > 0);
+
+		return Allocate(GeometryKind::Vertex, static_cast<vk::DeviceSize>(vertexCount) * stride, stride);
+	}
+
+	std::optional<GeometryRange> VulkanGlobalGeometryBuffer::AllocateIndices(
+	    uint32_t indexCount, vk::IndexType indexType
+	)
+	{
+		ER_CORE_ASSERT(indexCount > 0);
+		ER_CORE_ASSERT(
+		    indexType == vk::IndexType::eUint16 || indexType == vk::IndexType::eUint32,
+		    "8-bit indices need the indexTypeUint8 feature, which the device is not created with"
+		);
+
+		const uint32_t indexSize = GetIndexSize(indexType);
+		return Allocate(GeometryKind::Index, static_cast<vk::DeviceSize>(indexCount) * indexSize, indexSize);
+	}
+
+	void VulkanGlobalGeometryBuffer::Free(const GeometryRange& range)
+	{
+		if (!range.IsValid())
+			return;
+
+		std::lock_guard lock(m_Mutex);
+
+		const std::vector<Page>& pages = GetPages(range.Kind);
+		ER_CORE_ASSERT(range.Page < pages.size(), "Invalid geometry range!");
+
+		vmaVirtualFree(pages[range.Page].VirtualBlock, range.Allocation);
+	}
+
+	vk::Buffer VulkanGlobalGeometryBuffer::GetBuffer(const GeometryRange& range) const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		const std::vector<Page>& pages = GetPages(range.Kind);
+		ER_CORE_ASSERT(range.Page < pages.size(), "Invalid geometry range!");
+
+		return pages[range.Page].Buffer;
+	}
+
+	void VulkanGlobalGeometryBuffer::Bind(
+	    vk::CommandBuffer commandBuffer, uint32_t vertexPage, uint32_t indexPage, vk::IndexType indexType
+	) const
+	{
+		std::lock_guard lock(m_Mutex);
+		ER_CORE_ASSERT(vertexPage < m_VertexPages.size() && indexPage < m_IndexPages.size(), "Invalid page!");
+
+		commandBuffer.bindVertexBuffers(0, m_VertexPages[vertexPage].Buffer, vk::DeviceSize{0});
+		commandBuffer.bindIndexBuffer(m_IndexPages[indexPage].Buffer, 0, indexType);
+	}
+
+	GeometryBufferStats VulkanGlobalGeometryBuffer::GetStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		GeometryBufferStats stats{};
+		stats.PageCount = static_cast<uint32_t>(m_VertexPages.size() + m_IndexPages.size());
+
+		for (const Page& page : m_VertexPages)
+		{
+			VmaStatistics statistics;
+			vmaGetVirtualBlockStatistics(page.VirtualBlock, &statistics);
+
+			stats.VertexCapacity += page.Size;
+			stats.VertexUsed += statistics.allocationBytes;
+		}
+
+		for (const Page& page : m_IndexPages)
+		{
+			VmaStatistics statistics;
+			vmaGetVirtualBlockStatistics(page.VirtualBlock, &statistics);
+
+			stats.IndexCapacity += page.Size;
+			stats.IndexUsed += statistics.allocationBytes;
+		}
+
+		return stats;
+	}
+
+	std::optional<GeometryRange> VulkanGlobalGeometryBuffer::Allocate(
+	    GeometryKind kind, vk::DeviceSize size, uint32_t stride
+	)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		// Virtual allocations only take power of two alignments, other strides get slack to be aligned by hand
+		const bool powerOfTwoStride = std::has_single_bit(stride);
+
+		VmaVirtualAllocationCreateInfo allocInfo{};
+		allocInfo.size      = powerOfTwoStride ? size : size + stride - 1;
+		allocInfo.alignment = powerOfTwoStride ? stride : 1;
+
+		const auto tryAllocate = [&](uint32_t pageIndex) -> std::optional<GeometryRange>
+		{
+			VmaVirtualAllocation allocation;
+			vk::DeviceSize       offset;
+			if (vmaVirtualAllocate(GetPages(kind)[pageIndex].VirtualBlock, &allocInfo, &allocation, &offset) !=
+			    VK_SUCCESS)
+				return std::nullopt;
+
+			return GeometryRange{
+			    .Kind       = kind,
+			    .Page       = pageIndex,
+			    .Allocation = allocation,
+			    .Offset     = (offset + stride - 1) / stride * stride,
+			    .Size       = size,
+			    .Stride     = stride
+			};
+		};
+
+		const uint32_t pageCount = static_cast<uint32_t>(GetPages(kind).size());
+		for (uint32_t i = 0; i < pageCount; ++i)
+		{
+			if (std::optional<GeometryRange> range = tryAllocate(i))
+				return range;
+		}
+
+		if (!CreatePage(kind, allocInfo.size))
+			return std::nullopt;
+
+		std::optional<GeometryRange> range = tryAllocate(pageCount);
+		ER_CORE_ASSERT(range, "A new geometry page must fit the range it was created for!");
+		return range;
+	}
+
+	bool VulkanGlobalGeometryBuffer::CreatePage(GeometryKind kind, vk::DeviceSize minimumSize)
+	{
+		const bool isVertex = kind == GeometryKind::Vertex;
+
+		vk::BufferCreateInfo bufferCreateInfo{};
+		bufferCreateInfo.size  = std::max(isVertex ? m_VertexPageSize : m_IndexPageSize, minimumSize);
+		bufferCreateInfo.usage = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eStorageBuffer |
+		                         (isVertex ? vk::BufferUsageFlagBits::eVertexBuffer
+		                                   : vk::BufferUsageFlagBits::eIndexBuffer);
+		bufferCreateInfo.sharingMode = vk::SharingMode::eExclusive;
+
+		Page page;
+		auto allocation = m_Allocator->AllocateBuffer(bufferCreateInfo, MemoryUsage::AutoPreferDevice, page.Buffer);
+		if (!allocation)
+		{
+			ER_CORE_ERROR_TAG("Renderer", "Failed to allocate a geometry page of {} bytes", bufferCreateInfo.size);
+			return false;
+		}
+
+		page.Allocation = *allocation;
+		page.Size       = bufferCreateInfo.size;
+		m_Allocator->SetAllocationName(page.Allocation, isVertex ? "GeometryVertices" : "GeometryIndices");
+
+		VmaVirtualBlockCreateInfo blockCreateInfo{};
+		blockCreateInfo.size = page.Size;
+		VK_CHECK_RESULT(vmaCreateVirtualBlock(&blockCreateInfo, &page.VirtualBlock));
+
+		GetPages(kind).push_back(page);
+		return true;
+	}
+
+	std::vector<VulkanGlobalGeometryBuffer::Page>& VulkanGlobalGeometryBuffer::GetPages(GeometryKind kind)
+	{
+		return kind == GeometryKind::Vertex ? m_VertexPages : m_IndexPages;
+	}
+
+	const std::vector<VulkanGlobalGeometryBuffer::Page>& VulkanGlobalGeometryBuffer::GetPages(
+	    GeometryKind kind
+	) const
+	{
+		return kind == GeometryKind::Vertex ? m_VertexPages : m_IndexPages;
+	}
+}        // namespace Eruption
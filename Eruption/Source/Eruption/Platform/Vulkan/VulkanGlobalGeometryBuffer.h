@@ -0,0 +1,111 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Eruption
+{
+	enum class GeometryKind : uint8_t
+	{
+		Vertex,
+		Index
+	};
+
+	// A mesh's vertices or indices inside one page of the global geometry buffer
+	struct GeometryRange
+	{
+		GeometryKind         Kind       = GeometryKind::Vertex;
+		uint32_t             Page       = 0;
+		VmaVirtualAllocation Allocation = VK_NULL_HANDLE;
+		vk::DeviceSize       Offset     = 0;        // In bytes from the start of the page's buffer
+		vk::DeviceSize       Size       = 0;
+		uint32_t             Stride     = 0;        // Vertex stride or index size
+
+		[[nodiscard]] bool IsValid() const { return Allocation != VK_NULL_HANDLE; }
+
+		// The vertexOffset/firstIndex of a draw, the range is aligned to its stride
+		[[nodiscard]] uint32_t GetFirstElement() const { return static_cast<uint32_t>(Offset / Stride); }
+	};
+
+	struct GeometryBufferStats
+	{
+		vk::DeviceSize VertexCapacity = 0;
+		vk::DeviceSize VertexUsed     = 0;
+		vk::DeviceSize IndexCapacity  = 0;
+		vk::DeviceSize IndexUsed      = 0;
+		uint32_t       PageCount      = 0;
+	};
+
+	// Vertex and index data of all meshes, suballocated from a few large device-local buffers through VMA
+	// virtual blocks. Meshes sharing a page are drawn after binding its buffers once, with the ranges' first
+	// elements as vertex offset and first index:
+	//
+	//     geometry.Bind(commandBuffer, mesh.Vertices.Page, mesh.Indices.Page, vk::IndexType::eUint32);
+	//     commandBuffer.drawIndexed(
+	//         indexCount, 1, mesh.Indices.GetFirstElement(), static_cast<int32_t>(mesh.Vertices.GetFirstElement()), 0
+	//     );
+	//
+	// Upload into a range with VulkanStagingRing::UploadToBuffer at GetBuffer(range) and range.Offset. Pages are
+	// created on first use and another one is added when a range fits in none of them.
+	//
+	// Allocate and Free are safe to call from several threads.
+	class VulkanGlobalGeometryBuffer
+	{
+	public:
+		VulkanGlobalGeometryBuffer(
+		    const Ref<VulkanAllocator>& allocator, vk::DeviceSize vertexPageSize, vk::DeviceSize indexPageSize
+		);
+		~VulkanGlobalGeometryBuffer();
+
+		VulkanGlobalGeometryBuffer(const VulkanGlobalGeometryBuffer&)            = delete;
+		VulkanGlobalGeometryBuffer& operator=(const VulkanGlobalGeometryBuffer&) = delete;
+		VulkanGlobalGeometryBuffer(VulkanGlobalGeometryBuffer&&)                 = delete;
+		VulkanGlobalGeometryBuffer& operator=(VulkanGlobalGeometryBuffer&&)      = delete;
+
+		// Returns nullopt when a new page could not be allocated. Index types are eUint16 and eUint32 only.
+		[[nodiscard]] std::optional<GeometryRange> AllocateVertices(uint32_t vertexCount, uint32_t stride);
+		[[nodiscard]] std::optional<GeometryRange> AllocateIndices(uint32_t indexCount, vk::IndexType indexType);
+
+		// The range must no longer be read by the GPU, release it through the deletion queue while frames in
+		// flight may still draw it
+		void Free(const GeometryRange& range);
+
+		[[nodiscard]] vk::Buffer GetBuffer(const GeometryRange& range) const;
+
+		// Binds the vertex buffer of a vertex page at binding 0 and the index buffer of an index page
+		void Bind(
+		    vk::CommandBuffer commandBuffer, uint32_t vertexPage, uint32_t indexPage, vk::IndexType indexType
+		) const;
+
+		[[nodiscard]] GeometryBufferStats GetStats() const;
+
+	private:
+		struct Page
+		{
+			vk::Buffer      Buffer;
+			VmaAllocation   Allocation   = VK_NULL_HANDLE;
+			VmaVirtualBlock VirtualBlock = VK_NULL_HANDLE;
+			vk::DeviceSize  Size         = 0;
+		};
+
+		std::optional<GeometryRange> Allocate(GeometryKind kind, vk::DeviceSize size, uint32_t stride);
+		bool                         CreatePage(GeometryKind kind, vk::DeviceSize minimumSize);
+
+		[[nodiscard]] std::vector<Page>&       GetPages(GeometryKind kind);
+		[[nodiscard]] const std::vector<Page>& GetPages(GeometryKind kind) const;
+
+	private:
+		Ref<VulkanAllocator> m_Allocator;
+
+		vk::DeviceSize m_VertexPageSize = 0;
+		vk::DeviceSize m_IndexPageSize  = 0;
+
+		mutable std::mutex m_Mutex;
+		std::vector<Page>  m_VertexPages;
+		std::vector<Page>  m_IndexPages;
+	};
+}        // namespace Eruption
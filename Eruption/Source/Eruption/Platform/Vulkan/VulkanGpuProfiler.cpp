@@ -0,0 +1,251 @@
+#include "VulkanGpuProfiler.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+#include <array>
+
+namespace Eruption
+{
+	namespace
+	{
+		constexpr uint32_t FRAME_BEGIN_QUERY = 0;
+		constexpr uint32_t FRAME_END_QUERY   = 1;
+		constexpr uint32_t FIRST_SCOPE_QUERY = 2;
+
+		// Result value followed by its availability word, as laid out by eWithAvailability
+		struct QueryResult
+		{
+			uint64_t Ticks;
+			uint64_t Available;
+		};
+	}        // namespace
+
+	VulkanGpuProfiler::VulkanGpuProfiler(const Ref<VulkanDevice>& device, uint32_t framesInFlight) : m_Device(device)
+	{
+		const Ref<VulkanPhysicalDevice>& physicalDevice = m_Device->GetPhysicalDevice();
+
+		const uint32_t graphicsFamily = static_cast<uint32_t>(physicalDevice->GetQueueFamilyIndices().Graphics);
+		const std::vector queueFamilies = physicalDevice->GetVulkanPhysicalDevice().getQueueFamilyProperties();
+
+		m_TimestampValidBits = queueFamilies[graphicsFamily].timestampValidBits;
+		m_TimestampPeriod    = physicalDevice->GetProperties().properties.limits.timestampPeriod;
+		m_TimestampMask      = m_TimestampValidBits >= 64 ? UINT64_MAX : (uint64_t{1} << m_TimestampValidBits) - 1;
+
+		if (!IsSupported())
+		{
+			ER_CORE_WARN_TAG("Renderer", "Graphics queue does not support timestamps, GPU profiling is disabled");
+			return;
+		}
+
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		vk::QueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.queryType  = vk::QueryType::eTimestamp;
+		queryPoolCreateInfo.queryCount = QueriesPerPool;
+
+		m_Frames.resize(framesInFlight);
+		for (FrameData& frame : m_Frames)
+		{
+			frame.QueryPool = vulkanDevice.createQueryPool(queryPoolCreateInfo);
+			frame.Scopes.reserve(MaxScopesPerFrame);
+		}
+
+		m_Track = Profiler::CreateTrack("GPU");
+
+		Calibrate();
+	}
+
+	VulkanGpuProfiler::~VulkanGpuProfiler()
+	{
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		for (const FrameData& frame : m_Frames)
+			vulkanDevice.destroyQueryPool(frame.QueryPool);
+	}
+
+	void VulkanGpuProfiler::BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		if (!IsSupported())
+			return;
+
+		ER_CORE_ASSERT(frameIndex < m_Frames.size(), "Frame index out of range!");
+
+		FrameData& frame = m_Frames[frameIndex];
+		if (frame.Recorded)
+			ResolveFrame(frame);
+
+		frame.Scopes.clear();
+		frame.FrameNumber = m_FrameNumber++;
+		frame.Recorded    = true;
+
+		m_CurrentFrame = &frame;
+		m_ScopeDepth   = 0;
+
+		commandBuffer.resetQueryPool(frame.QueryPool, 0, QueriesPerPool);
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.QueryPool, FRAME_BEGIN_QUERY);
+	}
+
+	void VulkanGpuProfiler::EndFrame(vk::CommandBuffer commandBuffer)
+	{
+		if (!m_CurrentFrame)
+			return;
+
+		ER_CORE_ASSERT(m_ScopeDepth == 0, "GPU profile scope left open at the end of the frame!");
+
+		commandBuffer.writeTimestamp(
+		    vk::PipelineStageFlagBits::eBottomOfPipe, m_CurrentFrame->QueryPool, FRAME_END_QUERY
+		);
+		m_CurrentFrame = nullptr;
+	}
+
+	uint32_t VulkanGpuProfiler::BeginScope(vk::CommandBuffer commandBuffer, const char* name)
+	{
+		if (!m_CurrentFrame)
+			return InvalidScope;
+
+		std::vector<ScopeRecord>& scopes = m_CurrentFrame->Scopes;
+		if (scopes.size() >= MaxScopesPerFrame)
+		{
+			ER_CORE_WARN_TAG_ONCE("Renderer", "More than {0} GPU profile scopes in a frame", MaxScopesPerFrame);
+			return InvalidScope;
+		}
+
+		const auto     scope      = static_cast<uint32_t>(scopes.size());
+		const uint32_t beginQuery = FIRST_SCOPE_QUERY + scope * 2;
+		scopes.push_back({.Name = name, .Depth = m_ScopeDepth++, .BeginQuery = beginQuery});
+
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_CurrentFrame->QueryPool, beginQuery);
+
+		return scope;
+	}
+
+	void VulkanGpuProfiler::EndScope(vk::CommandBuffer commandBuffer, uint32_t scope)
+	{
+		if (!m_CurrentFrame || scope == InvalidScope)
+			return;
+
+		--m_ScopeDepth;
+
+		const uint32_t endQuery = m_CurrentFrame->Scopes[scope].BeginQuery + 1;
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_CurrentFrame->QueryPool, endQuery);
+	}
+
+	void VulkanGpuProfiler::Calibrate()
+	{
+		if (!IsSupported())
+			return;
+
+		ER_PROFILE_FUNCTION();
+
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		vk::QueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.queryType  = vk::QueryType::eTimestamp;
+		queryPoolCreateInfo.queryCount = 1;
+
+		const vk::QueryPool queryPool = vulkanDevice.createQueryPool(queryPoolCreateInfo);
+
+		const vk::CommandBuffer commandBuffer = m_Device->BeginSingleTimeCommands();
+		commandBuffer.resetQueryPool(queryPool, 0, 1);
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, queryPool, 0);
+
+		// The timestamp is taken somewhere between submit and fence signal; the midpoint is a good
+		// enough estimate without VK_KHR_calibrated_timestamps
+		const int64_t cpuBefore = Profiler::GetTimestamp();
+		m_Device->EndSingleTimeCommands(commandBuffer);
+		const int64_t cpuAfter = Profiler::GetTimestamp();
+
+		uint64_t         ticks  = 0;
+		const vk::Result result = vulkanDevice.getQueryPoolResults(
+		    queryPool, 0, 1, sizeof(ticks), &ticks, sizeof(ticks), vk::QueryResultFlagBits::e64
+		);
+		vulkanDevice.destroyQueryPool(queryPool);
+
+		if (result != vk::Result::eSuccess)
+		{
+			ER_CORE_WARN_TAG("Renderer", "GPU clock calibration failed: {0}", vk::to_string(result));
+			return;
+		}
+
+		m_ClockOffsetNs = cpuBefore + (cpuAfter - cpuBefore) / 2 - TicksToNanoseconds(ticks & m_TimestampMask);
+	}
+
+	void VulkanGpuProfiler::ResolveFrame(FrameData& frame)
+	{
+		ER_PROFILE_FUNCTION();
+
+		const uint32_t queryCount = FIRST_SCOPE_QUERY + static_cast<uint32_t>(frame.Scopes.size()) * 2;
+
+		std::array<QueryResult, QueriesPerPool> results{};
+
+		// Never waits: the slot's fence has already been waited on, so anything missing is a skipped frame
+		const vk::Result result = m_Device->GetVulkanDevice().getQueryPoolResults(
+		    frame.QueryPool,
+		    0,
+		    queryCount,
+		    queryCount * sizeof(QueryResult),
+		    results.data(),
+		    sizeof(QueryResult),
+		    vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability
+		);
+
+		if (result != vk::Result::eSuccess && result != vk::Result::eNotReady)
+		{
+			ER_CORE_WARN_TAG_RATE_LIMITED(
+			    "Renderer", 1000, "Reading GPU timestamps failed: {0}", vk::to_string(result)
+			);
+			return;
+		}
+
+		const QueryResult& frameBegin = results[FRAME_BEGIN_QUERY];
+		const QueryResult& frameEnd   = results[FRAME_END_QUERY];
+		if (!frameBegin.Available || !frameEnd.Available)
+			return;
+
+		// Offsets from the frame begin are taken modulo the valid bits, so counter wrap-around is harmless
+		const uint64_t beginTicks   = frameBegin.Ticks & m_TimestampMask;
+		const int64_t  frameStartNs = m_ClockOffsetNs + TicksToNanoseconds(beginTicks);
+		const auto     toProfilerNs = [&](uint64_t ticks) {
+			return frameStartNs + TicksToNanoseconds((ticks - beginTicks) & m_TimestampMask);
+		};
+
+		m_LastFrameTimings.FrameNumber = frame.FrameNumber;
+		m_LastFrameTimings.Scopes.clear();
+
+		const int64_t frameEndNs     = toProfilerNs(frameEnd.Ticks);
+		m_LastFrameTimings.GpuTimeMs = static_cast<double>(frameEndNs - frameStartNs) * 1e-6;
+
+		static MetricHistogram& s_GpuFrameTime =
+		    Metrics::GetHistogram("eruption_gpu_frame_time_microseconds", "GPU time per frame");
+		s_GpuFrameTime.Record(static_cast<uint64_t>(std::max(frameEndNs - frameStartNs, int64_t{0}) / 1000));
+
+		Profiler::RecordZone(
+		    m_Track, {.Name = "GPU Frame", .StartNs = frameStartNs, .EndNs = frameEndNs, .Depth = 0}
+		);
+
+		for (const ScopeRecord& scope : frame.Scopes)
+		{
+			const QueryResult& begin = results[scope.BeginQuery];
+			const QueryResult& end   = results[scope.BeginQuery + 1];
+			if (!begin.Available || !end.Available)
+				continue;
+
+			const GpuScopeTiming& timing = m_LastFrameTimings.Scopes.emplace_back(GpuScopeTiming{
+			    .Name    = scope.Name,
+			    .Depth   = scope.Depth,
+			    .StartNs = toProfilerNs(begin.Ticks),
+			    .EndNs   = toProfilerNs(end.Ticks)
+			});
+
+			Profiler::RecordZone(
+			    m_Track,
+			    {.Name = timing.Name, .StartNs = timing.StartNs, .EndNs = timing.EndNs, .Depth = timing.Depth + 1}
+			);
+		}
+	}
+
+	int64_t VulkanGpuProfiler::TicksToNanoseconds(uint64_t ticks) const
+	{
+		return static_cast<int64_t>(static_cast<double>(ticks) * m_TimestampPeriod);
+	}
+}        // namespace Eruption
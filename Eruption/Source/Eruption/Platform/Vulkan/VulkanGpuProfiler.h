@@ -0,0 +1,128 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Debug/Profiler.h"
+#include "Eruption/Platform/Vulkan/VulkanDevice.h"
+
+#include <vector>
+
+namespace Eruption
+{
+	struct GpuScopeTiming
+	{
+		const char* Name    = nullptr;
+		uint32_t    Depth   = 0;
+		int64_t     StartNs = 0;        // On the Profiler clock
+		int64_t     EndNs   = 0;
+
+		[[nodiscard]] double GetDurationMs() const { return static_cast<double>(EndNs - StartNs) * 1e-6; }
+	};
+
+	struct GpuFrameTimings
+	{
+		uint64_t                    FrameNumber = 0;
+		double                      GpuTimeMs   = 0.0;
+		std::vector<GpuScopeTiming> Scopes;
+	};
+
+	// Timestamp queries around command buffer regions. Every frame in flight owns a query pool, and its
+	// results are read back when the slot is reused FramesInFlight frames later, so nothing ever waits
+	// on the GPU. Resolved scopes are also written to a "GPU" track of the CPU profiler.
+	class VulkanGpuProfiler
+	{
+	public:
+		static constexpr uint32_t MaxScopesPerFrame = 256;
+
+		VulkanGpuProfiler(const Ref<VulkanDevice>& device, uint32_t framesInFlight);
+		~VulkanGpuProfiler();
+
+		VulkanGpuProfiler(const VulkanGpuProfiler&)            = delete;
+		VulkanGpuProfiler& operator=(const VulkanGpuProfiler&) = delete;
+		VulkanGpuProfiler(VulkanGpuProfiler&&)                 = delete;
+		VulkanGpuProfiler& operator=(VulkanGpuProfiler&&)      = delete;
+
+		// Resolves the queries this slot recorded FramesInFlight frames ago, then resets them. Must be recorded
+		// outside a render pass, after the fence of the frame previously using this slot has been waited on.
+		void BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex);
+		void EndFrame(vk::CommandBuffer commandBuffer);
+
+		// Returns a handle for EndScope; scopes may nest but must not span frames
+		[[nodiscard]] uint32_t BeginScope(vk::CommandBuffer commandBuffer, const char* name);
+		void                   EndScope(vk::CommandBuffer commandBuffer, uint32_t scope);
+
+		// Measures the offset between the GPU and CPU clocks. Stalls on a one-off submit, so only call it
+		// at startup or when timings visibly drift.
+		void Calibrate();
+
+		[[nodiscard]] bool IsSupported() const { return m_TimestampValidBits != 0; }
+
+		// Timings of the most recently resolved frame, FramesInFlight frames behind the one being recorded
+		[[nodiscard]] const GpuFrameTimings& GetLastFrameTimings() const { return m_LastFrameTimings; }
+
+	private:
+		static constexpr uint32_t InvalidScope   = UINT32_MAX;
+		static constexpr uint32_t QueriesPerPool = 2 + MaxScopesPerFrame * 2;        // Frame begin/end + scopes
+
+		struct ScopeRecord
+		{
+			const char* Name;
+			uint32_t    Depth;
+			uint32_t    BeginQuery;
+		};
+
+		struct FrameData
+		{
+			vk::QueryPool            QueryPool;
+			std::vector<ScopeRecord> Scopes;
+			uint64_t                 FrameNumber = 0;
+			bool                     Recorded    = false;
+		};
+
+		void ResolveFrame(FrameData& frame);
+
+		[[nodiscard]] int64_t TicksToNanoseconds(uint64_t ticks) const;
+
+	private:
+		Ref<VulkanDevice> m_Device;
+
+		std::vector<FrameData> m_Frames;
+		FrameData*             m_CurrentFrame = nullptr;
+		uint64_t               m_FrameNumber  = 0;
+		uint32_t               m_ScopeDepth   = 0;
+
+		double   m_TimestampPeriod    = 1.0;        // Nanoseconds per tick
+		uint32_t m_TimestampValidBits = 0;
+		uint64_t m_TimestampMask      = 0;
+
+		// Profiler clock time of GPU tick 0
+		int64_t m_ClockOffsetNs = 0;
+
+		ProfileTrack*   m_Track = nullptr;
+		GpuFrameTimings m_LastFrameTimings;
+	};
+
+	class VulkanGpuProfileScope
+	{
+	public:
+		VulkanGpuProfileScope(VulkanGpuProfiler& profiler, vk::CommandBuffer commandBuffer, const char* name) :
+		    m_Profiler(profiler), m_CommandBuffer(commandBuffer), m_Scope(profiler.BeginScope(commandBuffer, name))
+		{}
+
+		~VulkanGpuProfileScope() { m_Profiler.EndScope(m_CommandBuffer, m_Scope); }
+
+		VulkanGpuProfileScope(const VulkanGpuProfileScope&)            = delete;
+		VulkanGpuProfileScope& operator=(const VulkanGpuProfileScope&) = delete;
+
+	private:
+		VulkanGpuProfiler& m_Profiler;
+		vk::CommandBuffer  m_CommandBuffer;
+		uint32_t           m_Scope;
+	};
+}        // namespace Eruption
+
+#ifdef ER_ENABLE_PROFILING
+#	define ER_PROFILE_GPU_SCOPE(profiler, commandBuffer, name) \
+		::Eruption::VulkanGpuProfileScope ER_PROFILE_CONCAT(erGpuProfileScope, __LINE__)(profiler, commandBuffer, name)
+#else
+#	define ER_PROFILE_GPU_SCOPE(profiler, commandBuffer, name)
+#endif
@@ -0,0 +1,277 @@
+#include "VulkanPipelineStatistics.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <format>
+#include <unordered_map>
+
+namespace Eruption
+{
+	namespace
+	{
+		// Order of the values in a query result follows the bit order of the flags
+		constexpr vk::QueryPipelineStatisticFlags STATISTIC_FLAGS =
+		    vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices |
+		    vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives |
+		    vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+		    vk::QueryPipelineStatisticFlagBits::eClippingInvocations |
+		    vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+		    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations |
+		    vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations;
+
+		constexpr uint32_t STATISTIC_COUNT = sizeof(PipelineStatistics) / sizeof(uint64_t);
+		static_assert(STATISTIC_COUNT == 7, "PipelineStatistics must mirror STATISTIC_FLAGS");
+
+		// Statistic values followed by the availability word, as laid out by eWithAvailability
+		struct QueryResult
+		{
+			std::array<uint64_t, STATISTIC_COUNT> Values;
+			uint64_t                              Available;
+		};
+
+		PipelineStatistics ToStatistics(const QueryResult& result)
+		{
+			PipelineStatistics statistics;
+			std::memcpy(&statistics, result.Values.data(), sizeof(statistics));
+			return statistics;
+		}
+
+		struct StatisticMetric
+		{
+			const char*                  Name;        // Without the eruption_gpu_ prefix
+			uint64_t PipelineStatistics::*Member;
+		};
+
+		constexpr std::array<StatisticMetric, STATISTIC_COUNT> STATISTIC_METRICS = {{
+		    {"input_assembly_vertices", &PipelineStatistics::InputAssemblyVertices},
+		    {"input_assembly_primitives", &PipelineStatistics::InputAssemblyPrimitives},
+		    {"vertex_shader_invocations", &PipelineStatistics::VertexShaderInvocations},
+		    {"clipping_invocations", &PipelineStatistics::ClippingInvocations},
+		    {"clipping_primitives", &PipelineStatistics::ClippingPrimitives},
+		    {"fragment_shader_invocations", &PipelineStatistics::FragmentShaderInvocations},
+		    {"compute_shader_invocations", &PipelineStatistics::ComputeShaderInvocations},
+		}};
+
+		using StatisticGauges = std::array<MetricGauge*, STATISTIC_COUNT>;
+
+		// prefix is "" for the frame totals and "pass_<name>_" per pass
+		StatisticGauges RegisterGauges(std::string_view prefix, std::string_view help)
+		{
+			StatisticGauges gauges{};
+			for (uint32_t i = 0; i < STATISTIC_COUNT; ++i)
+			{
+				const std::string name = std::format("eruption_gpu_{0}{1}", prefix, STATISTIC_METRICS[i].Name);
+				gauges[i]              = &Metrics::GetGauge(name, help);
+			}
+			return gauges;
+		}
+
+		void SetGauges(const StatisticGauges& gauges, const PipelineStatistics& statistics)
+		{
+			for (uint32_t i = 0; i < STATISTIC_COUNT; ++i)
+				gauges[i]->Set(static_cast<int64_t>(statistics.*STATISTIC_METRICS[i].Member));
+		}
+
+		// Metric names only allow [a-zA-Z0-9_], so "Shadow Pass" becomes shadow_pass
+		std::string GetPassMetricPrefix(std::string_view passName)
+		{
+			std::string prefix = "pass_";
+			for (const char c : passName)
+			{
+				const auto character = static_cast<unsigned char>(c);
+				prefix.push_back(std::isalnum(character) ? static_cast<char>(std::tolower(character)) : '_');
+			}
+			prefix.push_back('_');
+			return prefix;
+		}
+
+		// Publishes the totals as eruption_gpu_<statistic> and every pass as eruption_gpu_pass_<pass>_<statistic>.
+		// Passes not recorded in the frame read 0 rather than keeping the values of the last frame that had them.
+		void PublishMetrics(const PipelineStatistics& totals, const std::vector<PassStatistics>& passes)
+		{
+			static const StatisticGauges s_TotalGauges =
+			    RegisterGauges("", "Pipeline statistics of the last resolved frame, over all passes");
+			// Keyed by the pass name itself, which BeginPass requires to stay valid
+			static std::unordered_map<std::string_view, StatisticGauges> s_PassGauges;
+
+			SetGauges(s_TotalGauges, totals);
+
+			for (const auto& [name, gauges] : s_PassGauges)
+				SetGauges(gauges, {});
+
+			for (const PassStatistics& pass : passes)
+			{
+				auto it = s_PassGauges.find(pass.Name);
+				if (it == s_PassGauges.end())
+				{
+					const StatisticGauges gauges = RegisterGauges(
+					    GetPassMetricPrefix(pass.Name), "Pipeline statistics of one pass in the last resolved frame"
+					);
+					it = s_PassGauges.emplace(pass.Name, gauges).first;
+				}
+
+				SetGauges(it->second, pass.Statistics);
+			}
+		}
+	}        // namespace
+
+	PipelineStatistics& PipelineStatistics::operator+=(const PipelineStatistics& other)
+	{
+		InputAssemblyVertices += other.InputAssemblyVertices;
+		InputAssemblyPrimitives += other.InputAssemblyPrimitives;
+		VertexShaderInvocations += other.VertexShaderInvocations;
+		ClippingInvocations += other.ClippingInvocations;
+		ClippingPrimitives += other.ClippingPrimitives;
+		FragmentShaderInvocations += other.FragmentShaderInvocations;
+		ComputeShaderInvocations += other.ComputeShaderInvocations;
+		return *this;
+	}
+
+	VulkanPipelineStatistics::VulkanPipelineStatistics(const Ref<VulkanDevice>& device, uint32_t framesInFlight) :
+	    m_Device(device)
+	{
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		vk::QueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.queryType          = vk::QueryType::ePipelineStatistics;
+		queryPoolCreateInfo.queryCount         = MaxPassesPerFrame;
+		queryPoolCreateInfo.pipelineStatistics = STATISTIC_FLAGS;
+
+		m_Frames.resize(framesInFlight);
+		for (FrameData& frame : m_Frames)
+		{
+			frame.QueryPool = vulkanDevice.createQueryPool(queryPoolCreateInfo);
+			frame.PassNames.reserve(MaxPassesPerFrame);
+		}
+	}
+
+	VulkanPipelineStatistics::~VulkanPipelineStatistics()
+	{
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		for (const FrameData& frame : m_Frames)
+			vulkanDevice.destroyQueryPool(frame.QueryPool);
+	}
+
+	void VulkanPipelineStatistics::BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		ER_CORE_ASSERT(frameIndex < m_Frames.size(), "Frame index out of range!");
+		ER_CORE_ASSERT(!m_PassActive, "Pipeline statistics pass left open at the end of the frame!");
+
+		FrameData& frame = m_Frames[frameIndex];
+		if (frame.Recorded)
+		{
+			ResolveFrame(frame);
+			PublishMetrics(GetLastFrameTotals(), m_LastFrameStatistics);
+		}
+
+		frame.PassNames.clear();
+		frame.Recorded = true;
+
+		m_CurrentFrame = &frame;
+
+		commandBuffer.resetQueryPool(frame.QueryPool, 0, MaxPassesPerFrame);
+	}
+
+	uint32_t VulkanPipelineStatistics::BeginPass(vk::CommandBuffer commandBuffer, const char* name)
+	{
+		if (!m_CurrentFrame)
+			return InvalidPass;
+
+		ER_CORE_ASSERT(!m_PassActive, "Pipeline statistics passes cannot nest!");
+
+		std::vector<const char*>& passNames = m_CurrentFrame->PassNames;
+		if (passNames.size() >= MaxPassesPerFrame)
+		{
+			ER_CORE_WARN_TAG_ONCE("Renderer", "More than {0} pipeline statistics passes in a frame", MaxPassesPerFrame);
+			return InvalidPass;
+		}
+
+		const auto pass = static_cast<uint32_t>(passNames.size());
+		passNames.push_back(name);
+
+		commandBuffer.beginQuery(m_CurrentFrame->QueryPool, pass, {});
+		m_PassActive = true;
+
+		return pass;
+	}
+
+	void VulkanPipelineStatistics::EndPass(vk::CommandBuffer commandBuffer, uint32_t pass)
+	{
+		if (!m_CurrentFrame || pass == InvalidPass)
+			return;
+
+		commandBuffer.endQuery(m_CurrentFrame->QueryPool, pass);
+		m_PassActive = false;
+	}
+
+	const PassStatistics* VulkanPipelineStatistics::FindPass(std::string_view name) const
+	{
+		const auto it = std::ranges::find_if(m_LastFrameStatistics, [name](const PassStatistics& pass) {
+			return pass.Name == name;
+		});
+		return it != m_LastFrameStatistics.end() ? &*it : nullptr;
+	}
+
+	PipelineStatistics VulkanPipelineStatistics::GetLastFrameTotals() const
+	{
+		PipelineStatistics totals;
+		for (const PassStatistics& pass : m_LastFrameStatistics)
+			totals += pass.Statistics;
+		return totals;
+	}
+
+	void VulkanPipelineStatistics::ResolveFrame(FrameData& frame)
+	{
+		ER_PROFILE_FUNCTION();
+
+		m_LastFrameStatistics.clear();
+
+		const auto passCount = static_cast<uint32_t>(frame.PassNames.size());
+		if (passCount == 0)
+			return;
+
+		std::array<QueryResult, MaxPassesPerFrame> results{};
+
+		// Never waits: the slot's fence has already been waited on, so anything missing is a skipped frame
+		const vk::Result result = m_Device->GetVulkanDevice().getQueryPoolResults(
+		    frame.QueryPool,
+		    0,
+		    passCount,
+		    passCount * sizeof(QueryResult),
+		    results.data(),
+		    sizeof(QueryResult),
+		    vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability
+		);
+
+		if (result != vk::Result::eSuccess && result != vk::Result::eNotReady)
+		{
+			ER_CORE_WARN_TAG_RATE_LIMITED(
+			    "Renderer", 1000, "Reading pipeline statistics failed: {0}", vk::to_string(result)
+			);
+			return;
+		}
+
+		for (uint32_t pass = 0; pass < passCount; ++pass)
+		{
+			if (!results[pass].Available)
+				continue;
+
+			const std::string_view name = frame.PassNames[pass];
+
+			const auto it = std::ranges::find_if(m_LastFrameStatistics, [name](const PassStatistics& existing) {
+				return existing.Name == name;
+			});
+
+			const PipelineStatistics statistics = ToStatistics(results[pass]);
+			if (it != m_LastFrameStatistics.end())
+				it->Statistics += statistics;
+			else
+				m_LastFrameStatistics.push_back({.Name = frame.PassNames[pass], .Statistics = statistics});
+		}
+	}
+}        // namespace Eruption
@@ -0,0 +1,120 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Debug/Profiler.h"
+#include "Eruption/Platform/Vulkan/VulkanDevice.h"
+
+#include <string_view>
+#include <vector>
+
+namespace Eruption
+{
+	// Counters of the core pipelineStatisticsQuery feature; tessellation and geometry counters would need
+	// additional device features and are not collected
+	struct PipelineStatistics
+	{
+		uint64_t InputAssemblyVertices     = 0;
+		uint64_t InputAssemblyPrimitives   = 0;
+		uint64_t VertexShaderInvocations   = 0;
+		uint64_t ClippingInvocations       = 0;
+		uint64_t ClippingPrimitives        = 0;
+		uint64_t FragmentShaderInvocations = 0;
+		uint64_t ComputeShaderInvocations  = 0;
+
+		PipelineStatistics& operator+=(const PipelineStatistics& other);
+	};
+
+	struct PassStatistics
+	{
+		const char*        Name = nullptr;
+		PipelineStatistics Statistics;
+	};
+
+	// Pipeline statistics queries per named pass. Like VulkanGpuProfiler, every frame in flight owns a query
+	// pool whose results are read back when the slot is reused, so collecting them never stalls.
+	class VulkanPipelineStatistics
+	{
+	public:
+		static constexpr uint32_t MaxPassesPerFrame = 64;
+
+		VulkanPipelineStatistics(const Ref<VulkanDevice>& device, uint32_t framesInFlight);
+		~VulkanPipelineStatistics();
+
+		VulkanPipelineStatistics(const VulkanPipelineStatistics&)            = delete;
+		VulkanPipelineStatistics& operator=(const VulkanPipelineStatistics&) = delete;
+		VulkanPipelineStatistics(VulkanPipelineStatistics&&)                 = delete;
+		VulkanPipelineStatistics& operator=(VulkanPipelineStatistics&&)      = delete;
+
+		// Resolves the passes this slot recorded FramesInFlight frames ago, then resets its queries. Must be
+		// recorded outside a render pass, after the fence of the frame previously using this slot was waited on.
+		void BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex);
+
+		// Passes cannot nest, and must begin and end in the same subpass. Passes recorded several times in
+		// a frame under the same name are summed. The name must stay valid for the lifetime of the process,
+		// e.g. a string literal, as it also keys the pass's metrics.
+		[[nodiscard]] uint32_t BeginPass(vk::CommandBuffer commandBuffer, const char* name);
+		void                   EndPass(vk::CommandBuffer commandBuffer, uint32_t pass);
+
+		// Per-pass counters of the most recently resolved frame. They are also published as metrics, named
+		// eruption_gpu_pass_<pass>_<statistic> per pass and eruption_gpu_<statistic> for the totals.
+		[[nodiscard]] const std::vector<PassStatistics>& GetLastFrameStatistics() const
+		{
+			return m_LastFrameStatistics;
+		}
+
+		[[nodiscard]] const PassStatistics* FindPass(std::string_view name) const;
+
+		// Sum over all passes of the most recently resolved frame
+		[[nodiscard]] PipelineStatistics GetLastFrameTotals() const;
+
+	private:
+		static constexpr uint32_t InvalidPass = UINT32_MAX;
+
+		struct FrameData
+		{
+			vk::QueryPool            QueryPool;
+			std::vector<const char*> PassNames;
+			bool                     Recorded = false;
+		};
+
+		void ResolveFrame(FrameData& frame);
+
+	private:
+		Ref<VulkanDevice> m_Device;
+
+		std::vector<FrameData> m_Frames;
+		FrameData*             m_CurrentFrame = nullptr;
+		bool                   m_PassActive   = false;
+
+		std::vector<PassStatistics> m_LastFrameStatistics;
+	};
+
+	class VulkanPipelineStatisticsScope
+	{
+	public:
+		VulkanPipelineStatisticsScope(
+		    VulkanPipelineStatistics& statistics, vk::CommandBuffer commandBuffer, const char* name
+		) :
+		    m_Statistics(statistics), m_CommandBuffer(commandBuffer), m_Pass(statistics.BeginPass(commandBuffer, name))
+		{}
+
+		~VulkanPipelineStatisticsScope() { m_Statistics.EndPass(m_CommandBuffer, m_Pass); }
+
+		VulkanPipelineStatisticsScope(const VulkanPipelineStatisticsScope&)            = delete;
+		VulkanPipelineStatisticsScope& operator=(const VulkanPipelineStatisticsScope&) = delete;
+
+	private:
+		VulkanPipelineStatistics& m_Statistics;
+		vk::CommandBuffer         m_CommandBuffer;
+		uint32_t                  m_Pass;
+	};
+}        // namespace Eruption
+
+#ifdef ER_ENABLE_PROFILING
+#	define ER_PIPELINE_STATISTICS_SCOPE(statistics, commandBuffer, name)                                  \
+		::Eruption::VulkanPipelineStatisticsScope ER_PROFILE_CONCAT(erPipelineStatisticsScope, __LINE__)( \
+		    statistics, commandBuffer, name                                                               \
+		)
+#else
+#	define ER_PIPELINE_STATISTICS_SCOPE(statistics, commandBuffer, name)
+#endif
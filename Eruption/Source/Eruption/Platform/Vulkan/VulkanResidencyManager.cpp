@@ -0,0 +1,259 @@
+#include "VulkanResidencyManager.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+#include <algorithm>
+
+namespace Eruption
+{
+	namespace
+	{
+		MetricCounter& GetEvictionCounter()
+		{
+			static MetricCounter& s_Counter =
+			    Metrics::GetCounter("eruption_residency_evictions_total", "Allocations evicted to stay within budget");
+			return s_Counter;
+		}
+
+		MetricCounter& GetEvictedBytesCounter()
+		{
+			static MetricCounter& s_Counter =
+			    Metrics::GetCounter("eruption_residency_evicted_bytes_total", "Bytes evicted to stay within budget");
+			return s_Counter;
+		}
+
+		MetricCounter& GetOverBudgetCounter()
+		{
+			static MetricCounter& s_Counter = Metrics::GetCounter(
+			    "eruption_residency_over_budget_allocations_total", "Allocations that only succeeded over budget"
+			);
+			return s_Counter;
+		}
+
+		bool HasFlag(AllocationCreateFlags flags, AllocationCreateFlagBits bit)
+		{
+			return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(bit)) != 0;
+		}
+	}        // namespace
+
+	VulkanResidencyManager::VulkanResidencyManager(
+	    const Ref<VulkanDevice>&    device,
+	    const Ref<VulkanAllocator>& allocator,
+	    uint32_t                    framesInFlight,
+	    float                       evictionThreshold,
+	    float                       evictionTarget
+	) :
+	    m_Device(device),
+	    m_Allocator(allocator),
+	    m_FramesInFlight(framesInFlight),
+	    m_EvictionThreshold(evictionThreshold),
+	    m_EvictionTarget(evictionTarget)
+	{
+		ER_CORE_ASSERT(evictionTarget <= evictionThreshold, "The eviction target must not exceed the threshold!");
+
+		const uint32_t heapCount =
+		    m_Device->GetPhysicalDevice()->GetMemoryProperties().memoryProperties.memoryHeapCount;
+		m_HeapCooldownUntil.resize(heapCount, 0);
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanResidencyManager::AllocateBuffer(
+	    const vk::BufferCreateInfo& createInfo,
+	    MemoryUsage                 usage,
+	    vk::Buffer&                 outBuffer,
+	    AllocationCreateFlags       flags,
+	    std::source_location        location
+	)
+	{
+		const vk::DeviceBufferMemoryRequirements requirementsInfo(&createInfo);
+		const vk::DeviceSize                     size =
+		    m_Device->GetVulkanDevice().getBufferMemoryRequirements(requirementsInfo).memoryRequirements.size;
+
+		return AllocateWithinBudget(
+		    size,
+		    m_Allocator->FindMemoryTypeIndex(createInfo, usage, flags),
+		    flags,
+		    [&](AllocationCreateFlags allocationFlags)
+		    { return m_Allocator->AllocateBuffer(createInfo, usage, outBuffer, allocationFlags, location); }
+		);
+	}
+
+	std::expected<VmaAllocation, vk::Result> VulkanResidencyManager::AllocateImage(
+	    const vk::ImageCreateInfo& createInfo,
+	    MemoryUsage                usage,
+	    vk::Image&                 outImage,
+	    AllocationCreateFlags      flags,
+	    std::source_location       location
+	)
+	{
+		const vk::DeviceImageMemoryRequirements requirementsInfo(&createInfo);
+		const vk::DeviceSize                    size =
+		    m_Device->GetVulkanDevice().getImageMemoryRequirements(requirementsInfo).memoryRequirements.size;
+
+		return AllocateWithinBudget(
+		    size,
+		    m_Allocator->FindMemoryTypeIndex(createInfo, usage, flags),
+		    flags,
+		    [&](AllocationCreateFlags allocationFlags)
+		    { return m_Allocator->AllocateImage(createInfo, usage, outImage, allocationFlags, location); }
+		);
+	}
+
+	void VulkanResidencyManager::RegisterEvictable(
+	    VmaAllocation allocation, ResidencyPriority priority, EvictionCallback onEvict
+	)
+	{
+		ER_CORE_ASSERT(allocation && onEvict);
+
+		const AllocationInfo info      = m_Allocator->GetAllocationInfo(allocation);
+		const uint32_t       heapIndex = GetHeapIndex(info.MemoryType);
+
+		std::lock_guard lock(m_Mutex);
+		m_Evictables.insert_or_assign(
+		    allocation,
+		    Evictable{
+		        .Priority      = priority,
+		        .HeapIndex     = heapIndex,
+		        .Size          = info.Size,
+		        .LastUsedFrame = m_FrameNumber,
+		        .OnEvict       = std::move(onEvict)
+		    }
+		);
+	}
+
+	void VulkanResidencyManager::Unregister(VmaAllocation allocation)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Evictables.erase(allocation);
+	}
+
+	void VulkanResidencyManager::Touch(VmaAllocation allocation)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (const auto it = m_Evictables.find(allocation); it != m_Evictables.end())
+			it->second.LastUsedFrame = m_FrameNumber;
+	}
+
+	void VulkanResidencyManager::BeginFrame()
+	{
+		ER_PROFILE_FUNCTION();
+
+		uint64_t frameNumber;
+		{
+			std::lock_guard lock(m_Mutex);
+			frameNumber = ++m_FrameNumber;
+		}
+
+		// Makes VMA fetch the budget from the driver again
+		m_Allocator->SetCurrentFrameIndex(static_cast<uint32_t>(frameNumber));
+
+		const std::vector<MemoryBudget> budgets = m_Allocator->GetBudget();
+		for (uint32_t i = 0; i < budgets.size(); ++i)
+		{
+			const MemoryBudget& budget = budgets[i];
+			if (budget.Budget == 0 || budget.Usage <= static_cast<uint64_t>(budget.Budget * m_EvictionThreshold))
+				continue;
+
+			{
+				std::lock_guard lock(m_Mutex);
+				if (frameNumber < m_HeapCooldownUntil[i])
+					continue;
+			}
+
+			const auto target = static_cast<uint64_t>(budget.Budget * m_EvictionTarget);
+			Evict(i, budget.Usage - target);
+		}
+	}
+
+	vk::DeviceSize VulkanResidencyManager::Evict(uint32_t heapIndex, vk::DeviceSize bytes)
+	{
+		ER_PROFILE_FUNCTION();
+
+		std::vector<EvictionCallback> callbacks;
+		vk::DeviceSize                evicted = 0;
+		{
+			std::lock_guard lock(m_Mutex);
+
+			std::vector<std::unordered_map<VmaAllocation, Evictable>::iterator> candidates;
+			for (auto it = m_Evictables.begin(); it != m_Evictables.end(); ++it)
+			{
+				if (it->second.HeapIndex == heapIndex)
+					candidates.push_back(it);
+			}
+
+			std::ranges::sort(
+			    candidates,
+			    {},
+			    [](const auto& it) { return std::pair(it->second.Priority, it->second.LastUsedFrame); }
+			);
+
+			for (const auto& it : candidates)
+			{
+				if (evicted >= bytes)
+					break;
+
+				evicted += it->second.Size;
+				callbacks.push_back(std::move(it->second.OnEvict));
+				m_Evictables.erase(it);
+			}
+
+			if (!callbacks.empty())
+				m_HeapCooldownUntil[heapIndex] = m_FrameNumber + m_FramesInFlight;
+		}
+
+		if (callbacks.empty())
+			return 0;
+
+		ER_CORE_INFO_TAG(
+		    "Renderer", "Evicting {} allocations ({} bytes) from memory heap {}", callbacks.size(), evicted, heapIndex
+		);
+
+		// Outside the lock, owners may allocate lower detail replacements from their callbacks
+		for (const EvictionCallback& callback : callbacks)
+			callback();
+
+		GetEvictionCounter().Increment(callbacks.size());
+		GetEvictedBytesCounter().Increment(evicted);
+		return evicted;
+	}
+
+	uint32_t VulkanResidencyManager::GetHeapIndex(uint32_t memoryType) const
+	{
+		return m_Device->GetPhysicalDevice()->GetMemoryProperties().memoryProperties.memoryTypes[memoryType].heapIndex;
+	}
+
+	template <typename Allocate>
+	std::expected<VmaAllocation, vk::Result> VulkanResidencyManager::AllocateWithinBudget(
+	    vk::DeviceSize size, std::optional<uint32_t> memoryType, AllocationCreateFlags flags, Allocate&& allocate
+	)
+	{
+		AllocationCreateFlags withinBudget = flags;
+		withinBudget |= AllocationCreateFlagBits::WithinBudget;
+
+		std::expected<VmaAllocation, vk::Result> allocation = allocate(withinBudget);
+		if (allocation || allocation.error() != vk::Result::eErrorOutOfDeviceMemory)
+			return allocation;
+
+		// Make room in the heap of the memory type VMA tries first, other heaps would not help it
+		const vk::DeviceSize evicted = memoryType ? Evict(GetHeapIndex(*memoryType), size) : 0;
+
+		// Succeeds when the owners freed their memory right away rather than through the deletion queue
+		if (evicted > 0)
+		{
+			allocation = allocate(withinBudget);
+			if (allocation)
+				return allocation;
+		}
+
+		if (HasFlag(flags, AllocationCreateFlagBits::WithinBudget))
+			return allocation;
+
+		allocation = allocate(flags);
+		if (allocation)
+		{
+			GetOverBudgetCounter().Increment();
+			ER_CORE_WARN_TAG_ONCE("Renderer", "GPU memory is over budget, allocations may start to fail");
+		}
+
+		return allocation;
+	}
+}        // namespace Eruption
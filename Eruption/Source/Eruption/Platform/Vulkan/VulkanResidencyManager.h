@@ -0,0 +1,115 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Eruption
+{
+	// Lower priorities are evicted first, least recently used first within a priority
+	enum class ResidencyPriority : uint8_t
+	{
+		Low,           // Detail that is cheap to restream, e.g. the top mips of a texture
+		Normal,        // Cached meshes and textures not seen for a while
+		High           // Evicted only when nothing else is left
+	};
+
+	// Called when the allocation has to go. The owner must stop using the resource and release it, through the
+	// deletion queue if frames in flight may still use it. The allocation is already unregistered.
+	using EvictionCallback = std::function<void()>;
+
+	// Keeps GPU memory usage within the budget the driver reports for each heap. Allocations that can be
+	// recreated on demand are registered as evictable; once per frame the budget is polled, and when a heap
+	// goes above the eviction threshold its evictable allocations are released through their callbacks until
+	// the usage drops to the target.
+	//
+	// Allocations made through the manager are first tried within the budget. When that fails it evicts from
+	// the heap the allocation would land in and retries, then allocates over budget, so running short of memory
+	// on a shared GPU costs streamed detail instead of failing with eErrorOutOfDeviceMemory.
+	//
+	// Safe to use from several threads, eviction callbacks run on the thread that triggered the eviction.
+	class VulkanResidencyManager
+	{
+	public:
+		VulkanResidencyManager(
+		    const Ref<VulkanDevice>&    device,
+		    const Ref<VulkanAllocator>& allocator,
+		    uint32_t                    framesInFlight,
+		    float                       evictionThreshold,
+		    float                       evictionTarget
+		);
+		~VulkanResidencyManager() = default;
+
+		VulkanResidencyManager(const VulkanResidencyManager&)            = delete;
+		VulkanResidencyManager& operator=(const VulkanResidencyManager&) = delete;
+		VulkanResidencyManager(VulkanResidencyManager&&)                 = delete;
+		VulkanResidencyManager& operator=(VulkanResidencyManager&&)      = delete;
+
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> AllocateBuffer(
+		    const vk::BufferCreateInfo& createInfo,
+		    MemoryUsage                 usage,
+		    vk::Buffer&                 outBuffer,
+		    AllocationCreateFlags       flags    = AllocationCreateFlagBits::None,
+		    std::source_location        location = std::source_location::current()
+		);
+
+		[[nodiscard]] std::expected<VmaAllocation, vk::Result> AllocateImage(
+		    const vk::ImageCreateInfo& createInfo,
+		    MemoryUsage                usage,
+		    vk::Image&                 outImage,
+		    AllocationCreateFlags      flags    = AllocationCreateFlagBits::None,
+		    std::source_location       location = std::source_location::current()
+		);
+
+		void RegisterEvictable(VmaAllocation allocation, ResidencyPriority priority, EvictionCallback onEvict);
+
+		// Must be called before an evictable allocation is freed by its owner
+		void Unregister(VmaAllocation allocation);
+
+		// Marks the allocation as used this frame, which keeps it from being evicted before older ones
+		void Touch(VmaAllocation allocation);
+
+		// Refreshes the budget and evicts from the heaps above the threshold, called by VulkanContext::BeginFrame
+		void BeginFrame();
+
+		// Evicts allocations of the heap until at least the given number of bytes were released
+		vk::DeviceSize Evict(uint32_t heapIndex, vk::DeviceSize bytes);
+
+	private:
+		struct Evictable
+		{
+			ResidencyPriority Priority;
+			uint32_t          HeapIndex;
+			vk::DeviceSize    Size;
+			uint64_t          LastUsedFrame;
+			EvictionCallback  OnEvict;
+		};
+
+		template <typename Allocate>
+		std::expected<VmaAllocation, vk::Result> AllocateWithinBudget(
+		    vk::DeviceSize size, std::optional<uint32_t> memoryType, AllocationCreateFlags flags, Allocate&& allocate
+		);
+
+		[[nodiscard]] uint32_t GetHeapIndex(uint32_t memoryType) const;
+
+	private:
+		Ref<VulkanDevice>    m_Device;
+		Ref<VulkanAllocator> m_Allocator;
+
+		uint32_t m_FramesInFlight    = 0;
+		float    m_EvictionThreshold = 0.0f;
+		float    m_EvictionTarget    = 0.0f;
+
+		std::mutex                                   m_Mutex;
+		std::unordered_map<VmaAllocation, Evictable> m_Evictables;
+		uint64_t                                     m_FrameNumber = 0;
+
+		// Evicted memory is only freed once the frames using it complete, the heap is left alone until then
+		std::vector<uint64_t> m_HeapCooldownUntil;
+	};
+}        // namespace Eruption
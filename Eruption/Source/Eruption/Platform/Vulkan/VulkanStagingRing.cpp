@@ -0,0 +1,96 @@
+#include "VulkanStagingRing.h"
+
+#include "Eruption/Debug/Metrics.h"
+
+#include <cstring>
+
+namespace Eruption
+{
+	namespace
+	{
+		MetricCounter& GetUploadedBytesCounter()
+		{
+			static MetricCounter& s_Counter =
+			    Metrics::GetPerFrameCounter("eruption_staging_bytes_total", "Bytes allocated from the staging ring");
+			return s_Counter;
+		}
+
+		MetricCounter& GetOverflowCounter()
+		{
+			static MetricCounter& s_Counter = Metrics::GetCounter(
+			    "eruption_staging_overflows_total", "Staging ring allocations that did not fit the frame's region"
+			);
+			return s_Counter;
+		}
+	}        // namespace
+
+	VulkanStagingRing::VulkanStagingRing(
+	    const Ref<VulkanAllocator>& allocator, uint32_t framesInFlight, vk::DeviceSize frameCapacity
+	) :
+	    m_Ring(
+	        allocator,
+	        vk::BufferUsageFlagBits::eTransferSrc,
+	        MemoryUsage::CpuToGpu,
+	        framesInFlight,
+	        frameCapacity,
+	        "StagingRing",
+	        GetUploadedBytesCounter(),
+	        GetOverflowCounter()
+	    )
+	{
+	}
+
+	std::optional<StagingAllocation> VulkanStagingRing::Allocate(vk::DeviceSize size, vk::DeviceSize alignment)
+	{
+		const std::optional<FrameRingAllocation> allocation = m_Ring.Allocate(size, alignment);
+		if (!allocation)
+		{
+			ER_CORE_WARN_TAG_ONCE(
+			    "Renderer", "Staging ring is full ({0} bytes per frame), raise StagingBufferSize", GetFrameCapacity()
+			);
+			return std::nullopt;
+		}
+
+		return StagingAllocation{
+		    .Buffer = m_Ring.GetBuffer(),
+		    .Offset = allocation->Offset,
+		    .Size   = size,
+		    .Data   = allocation->Data
+		};
+	}
+
+	bool VulkanStagingRing::UploadToBuffer(
+	    vk::CommandBuffer commandBuffer, std::span<const std::byte> data, vk::Buffer dstBuffer, vk::DeviceSize dstOffset
+	)
+	{
+		const std::optional<StagingAllocation> staging = Allocate(data.size_bytes());
+		if (!staging)
+			return false;
+
+		std::memcpy(staging->Data, data.data(), data.size_bytes());
+
+		const vk::BufferCopy copyRegion{staging->Offset, dstOffset, staging->Size};
+		commandBuffer.copyBuffer(staging->Buffer, dstBuffer, copyRegion);
+		return true;
+	}
+
+	bool VulkanStagingRing::UploadToImage(
+	    vk::CommandBuffer          commandBuffer,
+	    std::span<const std::byte> data,
+	    vk::Image                  dstImage,
+	    vk::ImageLayout            dstLayout,
+	    vk::BufferImageCopy        region,
+	    vk::DeviceSize             alignment
+	)
+	{
+		const std::optional<StagingAllocation> staging = Allocate(data.size_bytes(), alignment);
+		if (!staging)
+			return false;
+
+		std::memcpy(staging->Data, data.data(), data.size_bytes());
+
+		region.bufferOffset = staging->Offset;
+		commandBuffer.copyBufferToImage(staging->Buffer, dstImage, dstLayout, region);
+		return true;
+	}
+}        // namespace Eruption
@@ -0,0 +1,85 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanFrameRing.h"
+
+#include <optional>
+#include <span>
+
+namespace Eruption
+{
+	// Upload space handed out by VulkanStagingRing, valid until the end of the frame it was allocated in
+	struct StagingAllocation
+	{
+		vk::Buffer     Buffer;
+		vk::DeviceSize Offset = 0;              // Into Buffer, use it as the source offset of the copy
+		vk::DeviceSize Size   = 0;
+		void*          Data   = nullptr;        // Persistently mapped, write the upload here
+
+		template <typename T>
+		[[nodiscard]] T* As() const
+		{
+			return static_cast<T*>(Data);
+		}
+	};
+
+	// Persistently mapped staging buffer split into one region per frame in flight. Uploads bump-allocate from
+	// the current frame's region, write through the mapping and record a copy; the region is reused once the
+	// fence of the frame that filled it has signaled, so no upload allocates or maps memory.
+	//
+	//     if (const auto staging = stagingRing.Allocate(vertices.size_bytes()))
+	//     {
+	//         std::memcpy(staging->Data, vertices.data(), vertices.size_bytes());
+	//         commandBuffer.copyBuffer(staging->Buffer, vertexBuffer, {{staging->Offset, 0, staging->Size}});
+	//     }
+	//
+	// Allocate is safe to call from several threads, BeginFrame and EndFrame are not.
+	class VulkanStagingRing
+	{
+	public:
+		static constexpr vk::DeviceSize DefaultAlignment = 16;
+
+		VulkanStagingRing(const Ref<VulkanAllocator>& allocator, uint32_t framesInFlight, vk::DeviceSize frameCapacity);
+
+		VulkanStagingRing(const VulkanStagingRing&)            = delete;
+		VulkanStagingRing& operator=(const VulkanStagingRing&) = delete;
+		VulkanStagingRing(VulkanStagingRing&&)                 = delete;
+		VulkanStagingRing& operator=(VulkanStagingRing&&)      = delete;
+
+		// See VulkanFrameRing::BeginFrame and VulkanFrameRing::EndFrame
+		void BeginFrame(uint32_t frameIndex) { m_Ring.BeginFrame(frameIndex); }
+		void EndFrame() { m_Ring.EndFrame(); }
+
+		// Returns nullopt when the frame's region is full; the caller can retry next frame or fall back to a
+		// dedicated staging buffer. Alignment does not have to be a power of two, so texel sizes such as 12
+		// work for buffer to image copies.
+		[[nodiscard]] std::optional<StagingAllocation> Allocate(
+		    vk::DeviceSize size, vk::DeviceSize alignment = DefaultAlignment
+		);
+
+		// Copies data into the ring and records the transfer. Return false when the ring is full.
+		bool UploadToBuffer(
+		    vk::CommandBuffer          commandBuffer,
+		    std::span<const std::byte> data,
+		    vk::Buffer                 dstBuffer,
+		    vk::DeviceSize             dstOffset = 0
+		);
+
+		// The image must be in dstLayout. region.bufferOffset is filled in, alignment must be a multiple of the
+		// texel block size.
+		bool UploadToImage(
+		    vk::CommandBuffer          commandBuffer,
+		    std::span<const std::byte> data,
+		    vk::Image                  dstImage,
+		    vk::ImageLayout            dstLayout,
+		    vk::BufferImageCopy        region,
+		    vk::DeviceSize             alignment = DefaultAlignment
+		);
+
+		[[nodiscard]] vk::DeviceSize GetFrameCapacity() const { return m_Ring.GetFrameCapacity(); }
+		[[nodiscard]] vk::DeviceSize GetFrameUsage() const { return m_Ring.GetFrameUsage(); }
+
+	private:
+		VulkanFrameRing m_Ring;
+	};
+}        // namespace Eruption
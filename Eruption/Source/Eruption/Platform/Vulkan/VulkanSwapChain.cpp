@@ -1,5 +1,6 @@
 #include "VulkanSwapChain.h"
 
+#include "Eruption/Debug/Metrics.h"
 #include "Eruption/Platform/Vulkan/VulkanContext.h"
 
 namespace Eruption
@@ -29,6 +30,8 @@ namespace Eruption
 	    vk::Semaphore signalSemaphore, vk::Fence signalFence, uint64_t timeout
 	)
 	{
+		ER_PROFILE_FUNCTION();
+
 		const vk::Device vkDevice = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
 
 		uint32_t imageIndex;
@@ -57,6 +60,8 @@ namespace Eruption
 	    uint32_t imageIndex, std::span<const vk::Semaphore> waitSemaphores
 	)
 	{
+		ER_PROFILE_FUNCTION();
+
 		const Ref<VulkanDevice> device = VulkanContext::GetCurrentDevice();
 
 		const vk::PresentInfoKHR presentInfo(waitSemaphores, m_SwapChain, imageIndex);
@@ -83,24 +88,31 @@ namespace Eruption
 
 	void VulkanSwapChain::Recreate(const vk::Extent2D& newExtent)
 	{
+		ER_PROFILE_FUNCTION();
+
 		ER_CORE_INFO_TAG("Renderer", "Recreating swap chain with extent {}x{}", newExtent.width, newExtent.height);
 
-		const vk::Device vulkanDevice = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
-		vulkanDevice.waitIdle();
+		static MetricCounter& s_Recreations =
+		    Metrics::GetCounter("eruption_swapchain_recreations_total", "Swap chain recreations");
+		s_Recreations.Increment();
+
+		// Frames in flight may still render to the old image views and present from the old swap chain, so both
+		// are retired through the deletion queue instead of waiting for the device to go idle
+		VulkanDeletionQueue& deletionQueue = VulkanContext::Get()->GetDeletionQueue();
 
 		m_Specification.DesiredExtent = newExtent;
 
 		const vk::SwapchainKHR oldSwapChain = m_SwapChain;
 
 		for (auto& imageView : m_ImageViews)
-			vulkanDevice.destroyImageView(imageView);
+			deletionQueue.DestroyImageView(imageView);
 		m_ImageViews.clear();
 
-		// Create new swap chain
+		// Create new swap chain, the old one is passed as oldSwapchain and retired by it
 		Create();
 
 		if (oldSwapChain)
-			vulkanDevice.destroySwapchainKHR(oldSwapChain);
+			deletionQueue.DestroySwapchain(oldSwapChain);
 
 		m_IsSuboptimal = false;
 	}
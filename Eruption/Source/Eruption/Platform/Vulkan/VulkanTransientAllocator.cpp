@@ -0,0 +1,264 @@
+#include "VulkanTransientAllocator.h"
+
+#include "Eruption/Platform/Vulkan/VulkanContext.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Eruption
+{
+	namespace
+	{
+		bool LifetimesOverlap(uint32_t firstA, uint32_t lastA, uint32_t firstB, uint32_t lastB)
+		{
+			return firstA <= lastB && firstB <= lastA;
+		}
+
+		vk::DeviceSize AlignUp(vk::DeviceSize value, vk::DeviceSize alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}        // namespace
+
+	VulkanTransientAllocator::VulkanTransientAllocator(
+	    const Ref<VulkanDevice>& device, const Ref<VulkanAllocator>& allocator
+	) :
+	    m_Device(device), m_Allocator(allocator)
+	{}
+
+	VulkanTransientAllocator::~VulkanTransientAllocator()
+	{
+		Release();
+	}
+
+	uint32_t VulkanTransientAllocator::DeclareImage(
+	    std::string_view name, const vk::ImageCreateInfo& createInfo, uint32_t firstPass, uint32_t lastPass
+	)
+	{
+		ER_CORE_ASSERT(firstPass <= lastPass, "Invalid pass range!");
+		ER_CORE_ASSERT(createInfo.tiling == vk::ImageTiling::eOptimal, "Transient images must use optimal tiling!");
+		ER_CORE_ASSERT(createInfo.sharingMode == vk::SharingMode::eExclusive);
+
+		Resource& resource       = m_Resources.emplace_back();
+		resource.Name            = name;
+		resource.IsImage         = true;
+		resource.ImageCreateInfo = createInfo;
+		resource.FirstPass       = firstPass;
+		resource.LastPass        = lastPass;
+
+		return static_cast<uint32_t>(m_Resources.size() - 1);
+	}
+
+	uint32_t VulkanTransientAllocator::DeclareBuffer(
+	    std::string_view name, const vk::BufferCreateInfo& createInfo, uint32_t firstPass, uint32_t lastPass
+	)
+	{
+		ER_CORE_ASSERT(firstPass <= lastPass, "Invalid pass range!");
+		ER_CORE_ASSERT(createInfo.sharingMode == vk::SharingMode::eExclusive);
+
+		Resource& resource        = m_Resources.emplace_back();
+		resource.Name             = name;
+		resource.BufferCreateInfo = createInfo;
+		resource.FirstPass        = firstPass;
+		resource.LastPass         = lastPass;
+
+		return static_cast<uint32_t>(m_Resources.size() - 1);
+	}
+
+	void VulkanTransientAllocator::Build()
+	{
+		ER_PROFILE_FUNCTION();
+
+		Release();
+
+		const vk::Device vulkanDevice = m_Device->GetVulkanDevice();
+
+		m_RequestedBytes = 0;
+		for (Resource& resource : m_Resources)
+		{
+			if (resource.IsImage)
+			{
+				resource.Image        = vulkanDevice.createImage(resource.ImageCreateInfo);
+				resource.Requirements = vulkanDevice.getImageMemoryRequirements(resource.Image);
+			}
+			else
+			{
+				resource.Buffer       = vulkanDevice.createBuffer(resource.BufferCreateInfo);
+				resource.Requirements = vulkanDevice.getBufferMemoryRequirements(resource.Buffer);
+			}
+
+			m_RequestedBytes += resource.Requirements.size;
+		}
+
+		// Largest first, the small ones then fill the gaps between them
+		std::vector<uint32_t> order(m_Resources.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::ranges::stable_sort(
+		    order, std::ranges::greater{}, [this](uint32_t index) { return m_Resources[index].Requirements.size; }
+		);
+
+		for (const uint32_t index : order)
+			Place(index);
+
+		m_AllocatedBytes = 0;
+		for (Block& block : m_Blocks)
+		{
+			const vk::MemoryRequirements requirements{block.Size, block.Alignment, block.MemoryTypeBits};
+
+			auto allocation = m_Allocator->AllocateMemory(
+			    requirements, vk::MemoryPropertyFlagBits::eDeviceLocal, AllocationCreateFlagBits::CanAlias
+			);
+			ER_CORE_VERIFY(allocation, "Failed to allocate transient resource memory!");
+
+			block.Allocation = *allocation;
+			m_Allocator->SetAllocationName(
+			    block.Allocation, block.HoldsImages ? "TransientImages" : "TransientBuffers"
+			);
+			m_AllocatedBytes += block.Size;
+		}
+
+		for (const Resource& resource : m_Resources)
+		{
+			const VmaAllocation allocation = m_Blocks[resource.Block].Allocation;
+			if (resource.IsImage)
+				m_Allocator->BindImageMemory(allocation, resource.Offset, resource.Image);
+			else
+				m_Allocator->BindBufferMemory(allocation, resource.Offset, resource.Buffer);
+
+#ifdef ER_DEBUG
+			if (resource.IsImage)
+				VulkanUtils::SetDebugUtilsObjectName(
+				    vulkanDevice, vk::ObjectType::eImage, resource.Image, resource.Name
+				);
+			else
+				VulkanUtils::SetDebugUtilsObjectName(
+				    vulkanDevice, vk::ObjectType::eBuffer, resource.Buffer, resource.Name
+				);
+#endif
+		}
+
+		ER_CORE_INFO_TAG(
+		    "Renderer",
+		    "Built {} transient resources in {} blocks: {} bytes allocated for {} bytes requested",
+		    m_Resources.size(),
+		    m_Blocks.size(),
+		    m_AllocatedBytes,
+		    m_RequestedBytes
+		);
+	}
+
+	void VulkanTransientAllocator::Reset()
+	{
+		Release();
+		m_Resources.clear();
+	}
+
+	vk::Image VulkanTransientAllocator::GetImage(uint32_t index) const
+	{
+		ER_CORE_ASSERT(index < m_Resources.size() && m_Resources[index].IsImage, "Not a transient image!");
+		return m_Resources[index].Image;
+	}
+
+	vk::Buffer VulkanTransientAllocator::GetBuffer(uint32_t index) const
+	{
+		ER_CORE_ASSERT(index < m_Resources.size() && !m_Resources[index].IsImage, "Not a transient buffer!");
+		return m_Resources[index].Buffer;
+	}
+
+	vk::DeviceSize VulkanTransientAllocator::FindOffset(const Block& block, const Resource& resource) const
+	{
+		// Only resources alive at the same time get in the way
+		std::vector<const Resource*> conflicts;
+		for (const uint32_t index : block.Resources)
+		{
+			const Resource& placed = m_Resources[index];
+			if (LifetimesOverlap(placed.FirstPass, placed.LastPass, resource.FirstPass, resource.LastPass))
+				conflicts.push_back(&placed);
+		}
+
+		std::ranges::sort(conflicts, {}, &Resource::Offset);
+
+		// Lowest gap that fits, past the end of the block grows it
+		const vk::DeviceSize alignment = resource.Requirements.alignment;
+		vk::DeviceSize       offset    = 0;
+		for (const Resource* conflict : conflicts)
+		{
+			if (AlignUp(offset, alignment) + resource.Requirements.size <= conflict->Offset)
+				break;
+
+			offset = std::max(offset, conflict->Offset + conflict->Requirements.size);
+		}
+
+		return AlignUp(offset, alignment);
+	}
+
+	void VulkanTransientAllocator::Place(uint32_t resourceIndex)
+	{
+		Resource& resource = m_Resources[resourceIndex];
+
+		const auto it = std::ranges::find_if(
+		    m_Blocks,
+		    [&](const Block& block)
+		    {
+			    return block.HoldsImages == resource.IsImage &&
+			           (block.MemoryTypeBits & resource.Requirements.memoryTypeBits) != 0;
+		    }
+		);
+
+		resource.Block = static_cast<uint32_t>(it - m_Blocks.begin());
+		if (it == m_Blocks.end())
+			m_Blocks.emplace_back().HoldsImages = resource.IsImage;
+
+		Block& block    = m_Blocks[resource.Block];
+		resource.Offset = FindOffset(block, resource);
+
+		block.Size      = std::max(block.Size, resource.Offset + resource.Requirements.size);
+		block.Alignment = std::max(block.Alignment, resource.Requirements.alignment);
+		block.MemoryTypeBits &= resource.Requirements.memoryTypeBits;
+		block.Resources.push_back(resourceIndex);
+	}
+
+	void VulkanTransientAllocator::Release()
+	{
+		if (m_Blocks.empty())
+			return;
+
+		std::vector<vk::Image>     images;
+		std::vector<vk::Buffer>    buffers;
+		std::vector<VmaAllocation> allocations;
+
+		for (Resource& resource : m_Resources)
+		{
+			if (resource.Image)
+				images.push_back(std::exchange(resource.Image, nullptr));
+			if (resource.Buffer)
+				buffers.push_back(std::exchange(resource.Buffer, nullptr));
+		}
+
+		for (const Block& block : m_Blocks)
+		{
+			if (block.Allocation)
+				allocations.push_back(block.Allocation);
+		}
+
+		m_Blocks.clear();
+		m_AllocatedBytes = 0;
+
+		// Frames in flight may still use them, resources go before the memory they are bound to
+		VulkanContext::Get()->GetDeletionQueue().Enqueue(
+		    [vulkanDevice = m_Device->GetVulkanDevice(),
+		     allocator    = m_Allocator,
+		     images       = std::move(images),
+		     buffers      = std::move(buffers),
+		     allocations  = std::move(allocations)]
+		    {
+			    for (const vk::Image image : images)
+				    vulkanDevice.destroyImage(image);
+			    for (const vk::Buffer buffer : buffers)
+				    vulkanDevice.destroyBuffer(buffer);
+			    for (const VmaAllocation allocation : allocations)
+				    allocator->FreeMemory(allocation);
+		    }
+		);
+	}
+}        // namespace Eruption
@@ -0,0 +1,101 @@
+#pragma once
+#include "Eruption/Core/Base.h"
+
+#include "Eruption/Platform/Vulkan/VulkanAllocator.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Eruption
+{
+	// Render targets and scratch buffers that only live for part of a frame. Each resource is declared with
+	// the first and last pass that use it; Build creates them all and places resources whose pass ranges do
+	// not overlap in the same memory, so a post-process chain needs about as much memory as the intermediates
+	// that are alive at the same time:
+	//
+	//     const uint32_t bloomDown = transients.DeclareImage("BloomDown", bloomCreateInfo, 2, 3);
+	//     const uint32_t bloomUp   = transients.DeclareImage("BloomUp", bloomCreateInfo, 4, 5);        // Aliases
+	//     transients.Build();
+	//
+	// A resource sharing memory has undefined contents at its first pass: transition it from eUndefined, after
+	// a barrier against the last pass of whatever used the memory before it. Build again when the declarations
+	// change, e.g. on resize, the previous resources are released through the deletion queue.
+	//
+	// Not thread-safe, use it from the render thread.
+	class VulkanTransientAllocator
+	{
+	public:
+		VulkanTransientAllocator(const Ref<VulkanDevice>& device, const Ref<VulkanAllocator>& allocator);
+		~VulkanTransientAllocator();
+
+		VulkanTransientAllocator(const VulkanTransientAllocator&)            = delete;
+		VulkanTransientAllocator& operator=(const VulkanTransientAllocator&) = delete;
+		VulkanTransientAllocator(VulkanTransientAllocator&&)                 = delete;
+		VulkanTransientAllocator& operator=(VulkanTransientAllocator&&)      = delete;
+
+		// Passes are numbered in execution order within the frame, the range is inclusive. Images must use
+		// optimal tiling and both must use exclusive sharing. Returns the index passed to GetImage/GetBuffer.
+		[[nodiscard]] uint32_t DeclareImage(
+		    std::string_view name, const vk::ImageCreateInfo& createInfo, uint32_t firstPass, uint32_t lastPass
+		);
+		[[nodiscard]] uint32_t DeclareBuffer(
+		    std::string_view name, const vk::BufferCreateInfo& createInfo, uint32_t firstPass, uint32_t lastPass
+		);
+
+		// Creates the declared resources and binds them to shared memory, replacing the previous build
+		void Build();
+
+		// Releases the resources and forgets the declarations
+		void Reset();
+
+		[[nodiscard]] vk::Image  GetImage(uint32_t index) const;
+		[[nodiscard]] vk::Buffer GetBuffer(uint32_t index) const;
+
+		// Memory actually allocated, and what the resources would need without aliasing
+		[[nodiscard]] vk::DeviceSize GetAllocatedBytes() const { return m_AllocatedBytes; }
+		[[nodiscard]] vk::DeviceSize GetRequestedBytes() const { return m_RequestedBytes; }
+
+	private:
+		struct Resource
+		{
+			std::string          Name;
+			bool                 IsImage = false;
+			vk::ImageCreateInfo  ImageCreateInfo;
+			vk::BufferCreateInfo BufferCreateInfo;
+			uint32_t             FirstPass = 0;
+			uint32_t             LastPass  = 0;
+
+			vk::Image              Image;
+			vk::Buffer             Buffer;
+			vk::MemoryRequirements Requirements;
+			uint32_t               Block  = 0;
+			vk::DeviceSize         Offset = 0;
+		};
+
+		// Images and buffers never share a block, so bufferImageGranularity does not apply
+		struct Block
+		{
+			VmaAllocation         Allocation     = VK_NULL_HANDLE;
+			bool                  HoldsImages    = false;
+			vk::DeviceSize        Size           = 0;
+			vk::DeviceSize        Alignment      = 1;
+			uint32_t              MemoryTypeBits = ~0u;
+			std::vector<uint32_t> Resources;
+		};
+
+		[[nodiscard]] vk::DeviceSize FindOffset(const Block& block, const Resource& resource) const;
+		void                         Place(uint32_t resourceIndex);
+		void                         Release();
+
+	private:
+		Ref<VulkanDevice>    m_Device;
+		Ref<VulkanAllocator> m_Allocator;
+
+		std::vector<Resource> m_Resources;
+		std::vector<Block>    m_Blocks;
+
+		vk::DeviceSize m_AllocatedBytes = 0;
+		vk::DeviceSize m_RequestedBytes = 0;
+	};
+}        // namespace Eruption
@@ -6,5 +6,20 @@ namespace Eruption
 	struct RendererConfig
 	{
 		uint32_t FramesInFlight = 3u;
+
+		// Upload space per frame in flight of the staging ring
+		uint64_t StagingBufferSize = 16ull * 1024 * 1024;
+
+		// Per-draw constants and dynamic vertex data per frame in flight
+		uint64_t FrameDataBufferSize = 8ull * 1024 * 1024;
+
+		// Sizes of the vertex and index buffers the global geometry buffer suballocates meshes from
+		uint64_t GeometryVertexPageSize = 128ull * 1024 * 1024;
+		uint64_t GeometryIndexPageSize  = 64ull * 1024 * 1024;
+
+		// Fractions of a memory heap's budget: above the threshold evictable allocations are released until the
+		// usage is back at the target
+		float MemoryEvictionThreshold = 0.9f;
+		float MemoryEvictionTarget    = 0.8f;
 	};
 }        // namespace Eruption
@@ -13,6 +13,15 @@ namespace Eruption
 
 		virtual void Create(GLFWwindow* window) = 0;
 
+		// Called at the start of every frame that is rendered, with Application::GetCurrentFrameIndex()
+		virtual void BeginFrame(uint32_t /*frameIndex*/) {}
+
+		// Called once the frame is recorded, before it is submitted and presented
+		virtual void EndFrame() {}
+
+		// Publishes the device memory budgets, called once per frame while live telemetry is open
+		virtual void PublishTelemetry() const {}
+
 		static Ref<RendererContext> Create();
 	};
 }        // namespace Eruption
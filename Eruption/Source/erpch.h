@@ -31,3 +31,4 @@
 #include "Eruption/Core/Base.h"
 #include "Eruption/Core/Events/Event.h"
 #include "Eruption/Core/Log.h"
+#include "Eruption/Debug/Profiler.h"
@@ -0,0 +1,320 @@
+#include "Report.h"
+
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+namespace Eruption::Benchmark
+{
+	namespace
+	{
+		constexpr int REPORT_VERSION = 1;
+
+		struct Tolerance
+		{
+			double Relative = 0.0;
+			double Absolute = 0.0;        // Slack for values close to the timer resolution
+		};
+
+		// The worst single frame is dominated by the scheduler, so *_max metrics are reported but never compared
+		std::optional<Tolerance> GetDefaultTolerance(std::string_view metric)
+		{
+			if (metric.ends_with("_max"))
+				return std::nullopt;
+
+			if (metric.starts_with("frame_time_"))
+			{
+				if (metric.ends_with("_p99"))
+					return Tolerance{.Relative = 0.25, .Absolute = 1.0};
+				if (metric.ends_with("_p90"))
+					return Tolerance{.Relative = 0.15, .Absolute = 0.5};
+
+				return Tolerance{.Relative = 0.10, .Absolute = 0.5};
+			}
+
+			// Scenarios are deterministic, so counters only move when the engine does more work
+			return Tolerance{.Relative = 0.01, .Absolute = 0.0};
+		}
+
+		// Reads the subset of JSON the reports use: objects, strings and numbers. Anything else is skipped.
+		class JsonReader
+		{
+		public:
+			explicit JsonReader(std::string_view text) : m_Text(text) {}
+
+			bool ReadReport(Report& report)
+			{
+				return ReadObject([&](const std::string& key) {
+					if (key == "scenarios")
+					{
+						return ReadObject([&](const std::string& scenario) {
+							return ReadNumbers(report.Scenarios[scenario]);
+						});
+					}
+
+					if (key == "tolerances")
+						return ReadNumbers(report.Tolerances);
+
+					return SkipValue();
+				});
+			}
+
+		private:
+			bool ReadNumbers(std::map<std::string, double>& numbers)
+			{
+				return ReadObject([&](const std::string& key) {
+					double value = 0.0;
+					if (!ReadNumber(value))
+						return false;
+
+					numbers[key] = value;
+					return true;
+				});
+			}
+
+			template <typename TMemberReader>
+			bool ReadObject(TMemberReader&& readMember)
+			{
+				if (!Consume('{'))
+					return false;
+
+				if (Consume('}'))
+					return true;
+
+				do
+				{
+					std::string key;
+					if (!ReadString(key) || !Consume(':') || !readMember(key))
+						return false;
+				} while (Consume(','));
+
+				return Consume('}');
+			}
+
+			bool ReadString(std::string& string)
+			{
+				if (!Consume('"'))
+					return false;
+
+				while (m_Position < m_Text.size() && m_Text[m_Position] != '"')
+				{
+					// Escapes are kept as written, report keys never contain them
+					if (m_Text[m_Position] == '\\' && m_Position + 1 < m_Text.size())
+						string.push_back(m_Text[m_Position++]);
+
+					string.push_back(m_Text[m_Position++]);
+				}
+
+				return Consume('"');
+			}
+
+			bool ReadNumber(double& value)
+			{
+				SkipWhitespace();
+
+				const char* begin       = m_Text.data() + m_Position;
+				const auto [end, error] = std::from_chars(begin, m_Text.data() + m_Text.size(), value);
+				if (error != std::errc())
+					return false;
+
+				m_Position += static_cast<size_t>(end - begin);
+				return true;
+			}
+
+			bool SkipValue()
+			{
+				SkipWhitespace();
+				if (m_Position >= m_Text.size())
+					return false;
+
+				switch (m_Text[m_Position])
+				{
+					case '{': return ReadObject([&](const std::string&) { return SkipValue(); });
+					case '"':
+					{
+						std::string ignored;
+						return ReadString(ignored);
+					}
+					case '[':
+					{
+						Consume('[');
+						if (Consume(']'))
+							return true;
+
+						do
+						{
+							if (!SkipValue())
+								return false;
+						} while (Consume(','));
+
+						return Consume(']');
+					}
+					default:
+					{
+						// Numbers, true, false and null
+						constexpr std::string_view delimiters = ",}] \t\r\n";
+						while (m_Position < m_Text.size() && !delimiters.contains(m_Text[m_Position]))
+							++m_Position;
+
+						return true;
+					}
+				}
+			}
+
+			bool Consume(char c)
+			{
+				SkipWhitespace();
+				if (m_Position >= m_Text.size() || m_Text[m_Position] != c)
+					return false;
+
+				++m_Position;
+				return true;
+			}
+
+			void SkipWhitespace()
+			{
+				while (m_Position < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Position])))
+					++m_Position;
+			}
+
+		private:
+			std::string_view m_Text;
+			size_t           m_Position = 0;
+		};
+
+		void AppendNumbers(std::string& out, const std::map<std::string, double>& numbers, std::string_view indent)
+		{
+			bool first = true;
+			for (const auto& [name, value] : numbers)
+			{
+				out.append(std::format("{0}\n{1}\"{2}\": {3}", first ? "" : ",", indent, name, value));
+				first = false;
+			}
+		}
+	}        // namespace
+
+	bool WriteReport(const Report& report, const std::filesystem::path& path)
+	{
+		std::string out = std::format("{{\n    \"version\": {0},\n    \"scenarios\": {{", REPORT_VERSION);
+
+		bool first = true;
+		for (const auto& [scenario, metrics] : report.Scenarios)
+		{
+			out.append(std::format("{0}\n        \"{1}\": {{", first ? "" : ",", scenario));
+			AppendNumbers(out, metrics, "            ");
+			out.append("\n        }");
+			first = false;
+		}
+		out.append("\n    }");
+
+		if (!report.Tolerances.empty())
+		{
+			out.append(",\n    \"tolerances\": {");
+			AppendNumbers(out, report.Tolerances, "        ");
+			out.append("\n    }");
+		}
+		out.append("\n}\n");
+
+		if (path.has_parent_path())
+		{
+			std::error_code error;
+			std::filesystem::create_directories(path.parent_path(), error);
+		}
+
+		std::ofstream file(path);
+		file << out;
+		return static_cast<bool>(file);
+	}
+
+	std::optional<Report> ReadReport(const std::filesystem::path& path)
+	{
+		std::ifstream file(path);
+		if (!file)
+			return std::nullopt;
+
+		std::stringstream text;
+		text << file.rdbuf();
+
+		Report report;
+		if (!JsonReader(text.view()).ReadReport(report))
+		{
+			std::cerr << std::format("'{0}' is not a valid benchmark report\n", path.string());
+			return std::nullopt;
+		}
+
+		return report;
+	}
+
+	uint32_t CompareReports(const Report& baseline, const Report& results)
+	{
+		uint32_t regressions = 0;
+
+		for (const auto& [scenario, baselineMetrics] : baseline.Scenarios)
+		{
+			const auto resultIt = results.Scenarios.find(scenario);
+			if (resultIt == results.Scenarios.end())
+			{
+				std::cout << std::format("{0}: not run, skipped\n", scenario);
+				continue;
+			}
+
+			std::cout << std::format("{0}:\n", scenario);
+
+			for (const auto& [metric, expected] : baselineMetrics)
+			{
+				const auto valueIt = resultIt->second.find(metric);
+				// Counted as a regression, e.g. heap metrics of a build without memory tracking must not pass
+				if (valueIt == resultIt->second.end())
+				{
+					std::cout << std::format("    {0:<28} MISSING from the results\n", metric);
+					++regressions;
+					continue;
+				}
+
+				std::optional<Tolerance> tolerance = GetDefaultTolerance(metric);
+				if (const auto overrideIt = baseline.Tolerances.find(metric); overrideIt != baseline.Tolerances.end())
+				{
+					const double absolute = tolerance ? tolerance->Absolute : 0.0;
+					tolerance             = Tolerance{.Relative = overrideIt->second, .Absolute = absolute};
+				}
+
+				const double actual = valueIt->second;
+				const double change = expected != 0.0 ? (actual - expected) / expected : (actual != 0.0 ? 1.0 : 0.0);
+
+				std::string verdict;
+				if (!tolerance)
+				{
+					verdict = "not compared";
+				}
+				else if (actual > expected * (1.0 + tolerance->Relative) + tolerance->Absolute)
+				{
+					verdict = std::format("REGRESSION (limit +{0:.0f}%)", tolerance->Relative * 100.0);
+					++regressions;
+				}
+				else if (actual < expected * (1.0 - tolerance->Relative) - tolerance->Absolute)
+				{
+					verdict = "improved, consider updating the baseline";
+				}
+				else
+				{
+					verdict = "ok";
+				}
+
+				std::cout << std::format(
+				    "    {0:<28} {1:>12.3f} -> {2:>12.3f} {3:>+8.1f}%  {4}\n",
+				    metric,
+				    expected,
+				    actual,
+				    change * 100.0,
+				    verdict
+				);
+			}
+		}
+
+		return regressions;
+	}
+}        // namespace Eruption::Benchmark
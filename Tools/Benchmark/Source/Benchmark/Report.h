@@ -0,0 +1,34 @@
+#pragma once
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace Eruption::Benchmark
+{
+	// Metric name to value for one scenario, e.g. "frame_time_us_p99" or "events_per_frame". Every metric is
+	// lower-is-better.
+	using ScenarioMetrics = std::map<std::string, double>;
+
+	// Results file and baseline share the format:
+	//
+	//     {
+	//         "version": 1,
+	//         "scenarios": { "<scenario>": { "<metric>": <number>, ... }, ... },
+	//         "tolerances": { "<metric>": <relative tolerance>, ... }
+	//     }
+	//
+	// Tolerances are optional and only read from the baseline, where they override the defaults per metric.
+	struct Report
+	{
+		std::map<std::string, ScenarioMetrics> Scenarios;
+		std::map<std::string, double>          Tolerances;
+	};
+
+	bool                                WriteReport(const Report& report, const std::filesystem::path& path);
+	[[nodiscard]] std::optional<Report> ReadReport(const std::filesystem::path& path);
+
+	// Prints a line per compared metric and returns the number of regressions, including baseline metrics missing
+	// from the results
+	uint32_t CompareReports(const Report& baseline, const Report& results);
+}        // namespace Eruption::Benchmark
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Eruption::Benchmark
+{
+	// A scripted workload run for a fixed number of frames. Scenarios must be deterministic: the same frame
+	// index always does the same work, so counters can be compared exactly against the baseline.
+	class Scenario
+	{
+	public:
+		virtual ~Scenario() = default;
+
+		[[nodiscard]] virtual std::string_view GetName() const = 0;
+
+		virtual void RunFrame(uint64_t frameIndex) = 0;
+	};
+
+	// All scenarios in the order they run. They are CPU-only: an offscreen rendering scenario, and with it a
+	// Vulkan calls per frame metric, needs a Vulkan context that can be created without a window and a renderer
+	// that records draws.
+	[[nodiscard]] std::vector<std::unique_ptr<Scenario>> CreateScenarios();
+}        // namespace Eruption::Benchmark
@@ -0,0 +1,158 @@
+#include "Scenario.h"
+
+#include "Eruption/Core/Events/EventBus.h"
+#include "Eruption/Core/Events/KeyEvent.h"
+#include "Eruption/Core/Events/MouseEvent.h"
+#include "Eruption/Core/LayerStack.h"
+
+#include <array>
+#include <format>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace Eruption::Benchmark
+{
+	namespace
+	{
+		// Only the bookkeeping of the application loop: layer updates, the event queue and the per-frame
+		// markers the runner closes every frame. Any change here is overhead every application pays.
+		class EmptyLoopScenario final : public Scenario
+		{
+		public:
+			static constexpr uint32_t LayerCount = 8;
+
+			EmptyLoopScenario()
+			{
+				for (uint32_t i = 0; i < LayerCount; ++i)
+					m_Layers.PushLayer(new Layer(std::format("Layer {0}", i)));
+			}
+
+			[[nodiscard]] std::string_view GetName() const override { return "empty_loop"; }
+
+			void RunFrame(uint64_t /*frameIndex*/) override
+			{
+				m_EventBus.ProcessQueue();
+
+				ER_PROFILE_SCOPE("Benchmark::UpdateLayers");
+				for (Layer* layer : m_Layers)
+				{
+					if (layer->IsEnabled())
+						layer->OnUpdate(1.0f / 60.0f);
+				}
+			}
+
+		private:
+			LayerStack m_Layers;
+			EventBus   m_EventBus;
+		};
+
+		// Input-heavy frames: immediate dispatch of mouse moves to several handlers and a queue of key events
+		class EventStormScenario final : public Scenario
+		{
+		public:
+			static constexpr uint32_t MouseHandlers       = 8;
+			static constexpr uint32_t KeyHandlers         = 4;
+			static constexpr uint32_t MouseEventsPerFrame = 4096;
+			static constexpr uint32_t KeyEventsPerFrame   = 1024;
+
+			EventStormScenario()
+			{
+				for (uint32_t i = 0; i < MouseHandlers; ++i)
+				{
+					m_EventBus.Subscribe<MouseMovedEvent>(
+					    [this](MouseMovedEvent& event) {
+						    m_Checksum += static_cast<uint64_t>(event.GetX() + event.GetY());
+						    return false;
+					    },
+					    i
+					);
+				}
+
+				for (uint32_t i = 0; i < KeyHandlers; ++i)
+				{
+					m_EventBus.Subscribe<KeyPressedEvent>([this](KeyPressedEvent& event) {
+						m_Checksum += static_cast<uint64_t>(event.GetKeyCode());
+						return false;
+					});
+				}
+			}
+
+			[[nodiscard]] std::string_view GetName() const override { return "event_storm"; }
+
+			void RunFrame(uint64_t frameIndex) override
+			{
+				for (uint32_t i = 0; i < MouseEventsPerFrame; ++i)
+				{
+					MouseMovedEvent event(static_cast<float>(i), static_cast<float>(frameIndex % 1024));
+					m_EventBus.Publish(event);
+				}
+
+				for (uint32_t i = 0; i < KeyEventsPerFrame; ++i)
+					m_EventBus.Queue(KeyPressedEvent(static_cast<KeyCode>(32 + i % 64), 0));
+
+				m_EventBus.ProcessQueue();
+			}
+
+		private:
+			EventBus m_EventBus;
+			uint64_t m_Checksum = 0;
+		};
+
+		// Short-lived heap allocations of mixed sizes through the engine pointer wrappers and standard
+		// containers, the pattern per-frame allocators are meant to remove
+		class AllocatorChurnScenario final : public Scenario
+		{
+		public:
+			static constexpr uint32_t ObjectsPerFrame = 4096;
+			static constexpr uint32_t StringsPerFrame = 1024;
+
+			struct SmallObject
+			{
+				std::array<uint64_t, 4> Data{};
+			};
+
+			struct LargeObject
+			{
+				std::array<uint64_t, 128> Data{};
+			};
+
+			[[nodiscard]] std::string_view GetName() const override { return "allocator_churn"; }
+
+			void RunFrame(uint64_t frameIndex) override
+			{
+				// Seeded per frame, so every run allocates the same sizes in the same order
+				std::mt19937 random(static_cast<uint32_t>(frameIndex));
+
+				std::vector<Ref<SmallObject>>   shared;
+				std::vector<Scope<LargeObject>> owned;
+				shared.reserve(ObjectsPerFrame);
+				owned.reserve(ObjectsPerFrame / 8);
+
+				for (uint32_t i = 0; i < ObjectsPerFrame; ++i)
+				{
+					shared.push_back(CreateRef<SmallObject>());
+					if (i % 8 == 0)
+						owned.push_back(CreateScope<LargeObject>());
+				}
+
+				std::unordered_map<uint32_t, std::string> strings;
+				for (uint32_t i = 0; i < StringsPerFrame; ++i)
+					strings.emplace(i, std::string(16 + random() % 240, 'x'));
+
+				std::vector<std::vector<uint32_t>> buffers(64);
+				for (std::vector<uint32_t>& buffer : buffers)
+					buffer.resize(random() % 4096);
+			}
+		};
+	}        // namespace
+
+	std::vector<std::unique_ptr<Scenario>> CreateScenarios()
+	{
+		std::vector<std::unique_ptr<Scenario>> scenarios;
+		scenarios.push_back(std::make_unique<EmptyLoopScenario>());
+		scenarios.push_back(std::make_unique<EventStormScenario>());
+		scenarios.push_back(std::make_unique<AllocatorChurnScenario>());
+		return scenarios;
+	}
+}        // namespace Eruption::Benchmark
@@ -0,0 +1,295 @@
+#include "Report.h"
+#include "Scenario.h"
+
+#include "Eruption/Core/Clock.h"
+#include "Eruption/Debug/MemoryTracker.h"
+#include "Eruption/Debug/Metrics.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Headless performance regression runner. Runs every scenario for a fixed number of frames without a window
+// or GPU, writes frame-time percentiles and per-frame engine counters as JSON and compares them against a
+// baseline, exiting with 1 when any metric regressed beyond its tolerance and with 2 when the baseline cannot
+// be read.
+//
+// Usage: Eruption-Benchmark [options]
+//     --frames <n>          Measured frames per scenario run, 2000 when omitted
+//     --warmup <n>          Frames run before measuring, 200 when omitted
+//     --repetitions <n>     Runs per scenario, each metric keeps the median run, 3 when omitted
+//     --scenario <name>     Only run this scenario, can be repeated
+//     --output <path>       Results file, BenchmarkResults.json when omitted
+//     --baseline <path>     Baseline to compare against
+//     --update-baseline     Write the results to the baseline path instead of comparing
+//     --list                Print the scenario names and exit
+//
+// The committed baseline holds the deterministic counters, which are the same on every machine with the same
+// standard library: events and, in builds with ERUPTION_MEMORY_TRACKING, heap allocations and bytes per frame.
+// Frame times are machine specific: regenerate the baseline with --update-baseline on the machine that runs the
+// comparison to have them compared as well.
+
+namespace
+{
+	using namespace Eruption;
+	using namespace Eruption::Benchmark;
+
+	struct Options
+	{
+		uint32_t                 Frames      = 2000;
+		uint32_t                 Warmup      = 200;
+		uint32_t                 Repetitions = 3;
+		std::vector<std::string> Scenarios;
+		std::string              OutputPath = "BenchmarkResults.json";
+		std::string              BaselinePath;
+		bool                     UpdateBaseline = false;
+		bool                     List           = false;
+	};
+
+	// Engine side of the application loop, run after every scenario frame
+	void EndFrame()
+	{
+		ER_PROFILE_FRAME();
+		MemoryTracker::MarkFrame();
+		Metrics::MarkFrame();
+	}
+
+	double GetPercentile(const std::vector<double>& sorted, double percentile)
+	{
+		const size_t index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	}
+
+	ScenarioMetrics RunOnce(Scenario& scenario, const Options& options, uint64_t& frameIndex)
+	{
+		for (uint32_t i = 0; i < options.Warmup; ++i)
+		{
+			scenario.RunFrame(frameIndex++);
+			EndFrame();
+		}
+
+		MetricCounter& events = Metrics::GetCounter("eruption_events_dispatched_total");
+
+		std::vector<double> frameTimesUs;
+		frameTimesUs.reserve(options.Frames);
+
+		const uint64_t eventsBefore    = events.GetValue();
+		uint64_t       heapAllocations = 0;
+		uint64_t       heapBytes       = 0;
+
+		// Closes the heap counters, so the setup above does not count towards the first measured frame
+		MemoryTracker::MarkFrame();
+
+		for (uint32_t i = 0; i < options.Frames; ++i)
+		{
+			const int64_t start = Clock::GetTicks();
+
+			scenario.RunFrame(frameIndex++);
+			EndFrame();
+
+			frameTimesUs.push_back(Clock::ToNanoseconds(Clock::GetTicks() - start) * 1e-3);
+
+			const MemoryFrameStats heap = MemoryTracker::GetLastFrameStats();
+			heapAllocations += heap.Allocations;
+			heapBytes += heap.Bytes;
+		}
+
+		const double frames = options.Frames;
+
+		ScenarioMetrics metrics;
+		metrics["events_per_frame"] = static_cast<double>(events.GetValue() - eventsBefore) / frames;
+
+		if constexpr (MemoryTracker::IsEnabled())
+		{
+			metrics["heap_allocations_per_frame"] = static_cast<double>(heapAllocations) / frames;
+			metrics["heap_bytes_per_frame"]       = static_cast<double>(heapBytes) / frames;
+		}
+
+		metrics["frame_time_us_mean"] = std::accumulate(frameTimesUs.begin(), frameTimesUs.end(), 0.0) / frames;
+
+		std::ranges::sort(frameTimesUs);
+		metrics["frame_time_us_p50"] = GetPercentile(frameTimesUs, 0.50);
+		metrics["frame_time_us_p90"] = GetPercentile(frameTimesUs, 0.90);
+		metrics["frame_time_us_p99"] = GetPercentile(frameTimesUs, 0.99);
+		metrics["frame_time_us_max"] = frameTimesUs.back();
+
+		return metrics;
+	}
+
+	// Each metric independently takes its median over the repetitions, so one noisy run does not decide
+	ScenarioMetrics RunScenario(Scenario& scenario, const Options& options)
+	{
+		ER_PROFILE_SCOPE("Benchmark::RunScenario");
+
+		uint64_t                     frameIndex = 0;
+		std::vector<ScenarioMetrics> runs;
+		for (uint32_t i = 0; i < options.Repetitions; ++i)
+			runs.push_back(RunOnce(scenario, options, frameIndex));
+
+		ScenarioMetrics metrics;
+		for (const auto& [name, value] : runs.front())
+		{
+			std::vector<double> values;
+			for (const ScenarioMetrics& run : runs)
+				values.push_back(run.at(name));
+
+			std::ranges::sort(values);
+			metrics[name] = values[values.size() / 2];
+		}
+
+		return metrics;
+	}
+
+	bool ParseNumber(std::string_view text, uint32_t& value)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc() && end == text.data() + text.size() && value > 0;
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view argument = argv[i];
+			const bool             hasValue = i + 1 < argc;
+
+			if (argument == "--frames" && hasValue)
+			{
+				if (!ParseNumber(argv[++i], options.Frames))
+					return false;
+			}
+			else if (argument == "--warmup" && hasValue)
+			{
+				// Zero is allowed here
+				const std::string_view text = argv[++i];
+				if (text != "0" && !ParseNumber(text, options.Warmup))
+					return false;
+				if (text == "0")
+					options.Warmup = 0;
+			}
+			else if (argument == "--repetitions" && hasValue)
+			{
+				if (!ParseNumber(argv[++i], options.Repetitions))
+					return false;
+			}
+			else if (argument == "--scenario" && hasValue)
+				options.Scenarios.emplace_back(argv[++i]);
+			else if (argument == "--output" && hasValue)
+				options.OutputPath = argv[++i];
+			else if (argument == "--baseline" && hasValue)
+				options.BaselinePath = argv[++i];
+			else if (argument == "--update-baseline")
+				options.UpdateBaseline = true;
+			else if (argument == "--list")
+				options.List = true;
+			else
+				return false;
+		}
+
+		return !options.UpdateBaseline || !options.BaselinePath.empty();
+	}
+
+	int Run(const Options& options)
+	{
+		const std::vector<std::unique_ptr<Scenario>> scenarios = CreateScenarios();
+
+		if (options.List)
+		{
+			for (const auto& scenario : scenarios)
+				std::cout << scenario->GetName() << '\n';
+
+			return 0;
+		}
+
+		for (const std::string& name : options.Scenarios)
+		{
+			if (std::ranges::none_of(scenarios, [&](const auto& scenario) { return scenario->GetName() == name; }))
+			{
+				std::cerr << std::format("Unknown scenario '{0}', see --list\n", name);
+				return 2;
+			}
+		}
+
+		Report results;
+		for (const auto& scenario : scenarios)
+		{
+			const bool selected = options.Scenarios.empty() ||
+			                      std::ranges::find(options.Scenarios, scenario->GetName()) != options.Scenarios.end();
+			if (!selected)
+				continue;
+
+			std::cerr << std::format("Running {0}\n", scenario->GetName());
+			results.Scenarios[std::string(scenario->GetName())] = RunScenario(*scenario, options);
+		}
+
+		if (options.UpdateBaseline)
+		{
+			// Keep hand-tuned tolerances of the previous baseline
+			if (const std::optional<Report> previous = ReadReport(options.BaselinePath))
+				results.Tolerances = previous->Tolerances;
+
+			if (!WriteReport(results, options.BaselinePath))
+			{
+				std::cerr << std::format("Failed to write '{0}'\n", options.BaselinePath);
+				return 2;
+			}
+
+			std::cerr << std::format("Updated baseline '{0}'\n", options.BaselinePath);
+			return 0;
+		}
+
+		if (!WriteReport(results, options.OutputPath))
+		{
+			std::cerr << std::format("Failed to write '{0}'\n", options.OutputPath);
+			return 2;
+		}
+
+		if (options.BaselinePath.empty())
+			return 0;
+
+		const std::optional<Report> baseline = ReadReport(options.BaselinePath);
+		if (!baseline)
+		{
+			std::cerr << std::format(
+			    "Cannot read the baseline '{0}', create one with --update-baseline\n", options.BaselinePath
+			);
+			return 2;
+		}
+
+		const uint32_t regressions = CompareReports(*baseline, results);
+		if (regressions > 0)
+		{
+			std::cerr << std::format("{0} metrics regressed\n", regressions);
+			return 1;
+		}
+
+		return 0;
+	}
+}        // namespace
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		std::cerr << "Usage: Eruption-Benchmark [--frames <n>] [--warmup <n>] [--repetitions <n>] [--scenario <name>]"
+		             " [--output <path>] [--baseline <path>] [--update-baseline] [--list]\n";
+		return 2;
+	}
+
+	// Asynchronous logging, so a slow console does not show up as frame time
+	LogSpecification logSpecification;
+	logSpecification.Async = true;
+	Log::Init(logSpecification);
+	Profiler::SetThreadName("Main");
+
+	const int result = Run(options);
+
+	Log::Shutdown();
+	return result;
+}
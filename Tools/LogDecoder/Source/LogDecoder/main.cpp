@@ -0,0 +1,442 @@
+#include "Eruption/Core/BinaryLogFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Offline decoder for binary log files written by Eruption::BinaryLog.
+//
+// Usage: Eruption-LogDecoder <input> [output] [--source]
+//     output    Text file to write to, standard output when omitted
+//     --source  Append the file and line of the call site to every message
+
+namespace
+{
+	namespace Format = Eruption::BinaryLogFormat;
+
+	// Matches Eruption::Log::Level
+	constexpr std::array<std::string_view, 5> LEVEL_NAMES = {"Trace", "Info", "Warn", "Error", "Fatal"};
+
+	struct FormatDefinition
+	{
+		uint8_t                      Level = 0;
+		std::vector<Format::ArgType> ArgTypes;
+		std::string                  Tag;
+		std::string                  Text;
+		std::string                  File;
+		uint32_t                     Line = 0;
+	};
+
+	struct DecodedLine
+	{
+		int64_t     TimestampNs = 0;
+		std::string Text;
+	};
+
+	// Text of an ArgType::Formatted argument, written as is since the spec was meant for the original type
+	struct PreformattedText
+	{
+		std::string Text;
+	};
+
+	// A decoded argument that formats itself with the spec written at the call site
+	struct DecodedArg
+	{
+		std::variant<
+		    bool,
+		    char,
+		    int32_t,
+		    uint32_t,
+		    int64_t,
+		    uint64_t,
+		    float,
+		    double,
+		    std::string,
+		    const void*,
+		    PreformattedText>
+		    Value;
+	};
+}        // namespace
+
+template <>
+struct std::formatter<DecodedArg>
+{
+	std::string Spec;
+
+	constexpr auto parse(std::format_parse_context& context)
+	{
+		auto it = context.begin();
+		while (it != context.end() && *it != '}')
+			++it;
+
+		Spec.assign(context.begin(), it);
+		return it;
+	}
+
+	auto format(const DecodedArg& arg, std::format_context& context) const
+	{
+		return std::visit(
+		    [&](const auto& value) {
+			    if constexpr (std::same_as<std::decay_t<decltype(value)>, PreformattedText>)
+			    {
+				    return std::ranges::copy(value.Text, context.out()).out;
+			    }
+			    else
+			    {
+				    const std::string valueFormat = Spec.empty() ? std::string("{}") : "{:" + Spec + "}";
+				    return std::vformat_to(context.out(), valueFormat, std::make_format_args(value));
+			    }
+		    },
+		    arg.Value
+		);
+	}
+};
+
+namespace
+{
+	class Reader
+	{
+	public:
+		explicit Reader(std::istream& stream) : m_Stream(stream) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			return ReadBytes(&value, sizeof(T));
+		}
+
+		bool ReadBytes(void* data, size_t size)
+		{
+			m_Stream.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+			return static_cast<size_t>(m_Stream.gcount()) == size;
+		}
+
+		bool ReadString(std::string& string, size_t length)
+		{
+			string.resize(length);
+			return ReadBytes(string.data(), length);
+		}
+
+	private:
+		std::istream& m_Stream;
+	};
+
+	// Walks a message payload, every read is bounds checked against the payload size
+	class PayloadReader
+	{
+	public:
+		explicit PayloadReader(std::span<const std::byte> payload) : m_Payload(payload) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			if (m_Offset + sizeof(T) > m_Payload.size())
+				return false;
+
+			std::memcpy(&value, m_Payload.data() + m_Offset, sizeof(T));
+			m_Offset += sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string& string)
+		{
+			uint16_t length = 0;
+			if (!Read(length) || m_Offset + length > m_Payload.size())
+				return false;
+
+			string.assign(reinterpret_cast<const char*>(m_Payload.data() + m_Offset), length);
+			m_Offset += length;
+			return true;
+		}
+
+	private:
+		std::span<const std::byte> m_Payload;
+		size_t                     m_Offset = 0;
+	};
+
+	template <typename T>
+	bool DecodeValue(PayloadReader& reader, DecodedArg& arg)
+	{
+		T value{};
+		if (!reader.Read(value))
+			return false;
+
+		arg.Value = value;
+		return true;
+	}
+
+	bool DecodeArg(PayloadReader& reader, Format::ArgType type, DecodedArg& arg)
+	{
+		switch (type)
+		{
+			case Format::ArgType::Bool:
+			{
+				uint8_t value = 0;
+				if (!reader.Read(value))
+					return false;
+
+				arg.Value = value != 0;
+				return true;
+			}
+			case Format::ArgType::Char:   return DecodeValue<char>(reader, arg);
+			case Format::ArgType::Int32:  return DecodeValue<int32_t>(reader, arg);
+			case Format::ArgType::UInt32: return DecodeValue<uint32_t>(reader, arg);
+			case Format::ArgType::Int64:  return DecodeValue<int64_t>(reader, arg);
+			case Format::ArgType::UInt64: return DecodeValue<uint64_t>(reader, arg);
+			case Format::ArgType::Float:  return DecodeValue<float>(reader, arg);
+			case Format::ArgType::Double: return DecodeValue<double>(reader, arg);
+			case Format::ArgType::String:
+			{
+				std::string value;
+				if (!reader.ReadString(value))
+					return false;
+
+				arg.Value = std::move(value);
+				return true;
+			}
+			case Format::ArgType::Formatted:
+			{
+				PreformattedText value;
+				if (!reader.ReadString(value.Text))
+					return false;
+
+				arg.Value = std::move(value);
+				return true;
+			}
+			case Format::ArgType::Pointer:
+			{
+				uint64_t value = 0;
+				if (!reader.Read(value))
+					return false;
+
+				arg.Value = reinterpret_cast<const void*>(static_cast<uintptr_t>(value));
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <size_t... I>
+	std::string FormatArgs(std::string_view text, std::span<const DecodedArg> args, std::index_sequence<I...>)
+	{
+		return std::vformat(text, std::make_format_args(args[I]...));
+	}
+
+	// std::make_format_args needs the argument count at compile time, so dispatch on it through a table
+	using FormatFunction = std::string (*)(std::string_view, std::span<const DecodedArg>);
+
+	constexpr auto FORMAT_FUNCTIONS = []<size_t... N>(std::index_sequence<N...>) {
+		return std::array<FormatFunction, sizeof...(N)>{
+		    [](std::string_view text, std::span<const DecodedArg> args) {
+			    return FormatArgs(text, args, std::make_index_sequence<N>{});
+		    }...
+		};
+	}(std::make_index_sequence<Format::MaxArgs + 1>{});
+
+	std::string FormatMessage(const FormatDefinition& definition, std::span<const DecodedArg> args)
+	{
+		try
+		{
+			return FORMAT_FUNCTIONS[args.size()](definition.Text, args);
+		}
+		catch (const std::format_error& error)
+		{
+			return std::format("{0} <format error: {1}>", definition.Text, error.what());
+		}
+	}
+
+	std::string FormatTimestamp(int64_t wallClockNs)
+	{
+		using namespace std::chrono;
+
+		const sys_time<microseconds> time{duration_cast<microseconds>(nanoseconds(wallClockNs))};
+		return std::format("{0:%F %T}", time);
+	}
+
+	int Decode(std::istream& input, std::ostream& output, bool showSource)
+	{
+		Reader reader(input);
+
+		Format::FileHeader header;
+		if (!reader.Read(header) || header.FileMagic != Format::Magic)
+		{
+			std::cerr << "Input is not a binary log file\n";
+			return 1;
+		}
+
+		// Version 1 files only lack ArgType::Formatted, so they decode the same way
+		if (header.FileVersion == 0 || header.FileVersion > Format::Version)
+		{
+			std::cerr << std::format(
+			    "Unsupported binary log version {0}, expected at most {1}\n", header.FileVersion, Format::Version
+			);
+			return 1;
+		}
+
+		std::unordered_map<uint32_t, FormatDefinition> definitions;
+		std::vector<std::byte>                         payload;
+		std::vector<DecodedArg>                        args;
+		std::vector<DecodedLine>                       lines;
+
+		Format::RecordType recordType;
+		while (reader.Read(recordType))
+		{
+			switch (recordType)
+			{
+				case Format::RecordType::Format:
+				{
+					Format::FormatRecord record;
+					FormatDefinition     definition;
+
+					if (!reader.Read(record))
+						break;
+
+					definition.Level = record.Level;
+					definition.Line  = record.Line;
+					definition.ArgTypes.resize(record.ArgCount);
+
+					if (!reader.ReadBytes(definition.ArgTypes.data(), definition.ArgTypes.size()) ||
+					    !reader.ReadString(definition.Tag, record.TagLength) ||
+					    !reader.ReadString(definition.Text, record.FormatLength) ||
+					    !reader.ReadString(definition.File, record.FileLength))
+						break;
+
+					definitions[record.FormatID] = std::move(definition);
+					continue;
+				}
+				case Format::RecordType::Message:
+				{
+					Format::MessageRecord record;
+					if (!reader.Read(record))
+						break;
+
+					payload.resize(record.PayloadSize);
+					if (!reader.ReadBytes(payload.data(), payload.size()))
+						break;
+
+					const auto it = definitions.find(record.FormatID);
+					if (it == definitions.end())
+					{
+						std::cerr << std::format("Message references unknown format {0}, skipped\n", record.FormatID);
+						continue;
+					}
+
+					const FormatDefinition& definition = it->second;
+					if (definition.ArgTypes.size() > Format::MaxArgs)
+					{
+						std::cerr << std::format("Format {0} has too many arguments, skipped\n", record.FormatID);
+						continue;
+					}
+
+					PayloadReader payloadReader(payload);
+					args.resize(definition.ArgTypes.size());
+
+					bool valid = true;
+					for (size_t i = 0; i < args.size() && valid; ++i)
+						valid = DecodeArg(payloadReader, definition.ArgTypes[i], args[i]);
+
+					if (!valid)
+					{
+						std::cerr << std::format("Malformed payload for format {0}, skipped\n", record.FormatID);
+						continue;
+					}
+
+					const std::string_view level =
+					    definition.Level < LEVEL_NAMES.size() ? LEVEL_NAMES[definition.Level] : "Unknown";
+
+					DecodedLine& line = lines.emplace_back();
+					line.TimestampNs  = record.TimestampNs;
+					line.Text         = std::format(
+					    "[{0}] [{1}] [T{2}] ", FormatTimestamp(header.WallClockNs + record.TimestampNs), level,
+					    record.ThreadID
+					);
+
+					if (!definition.Tag.empty())
+						line.Text.append(std::format("[{0}] ", definition.Tag));
+
+					line.Text.append(FormatMessage(definition, args));
+
+					if (showSource)
+						line.Text.append(std::format(" ({0}:{1})", definition.File, definition.Line));
+
+					continue;
+				}
+				default:
+				{
+					std::cerr << std::format("Unknown record type {0}\n", static_cast<uint32_t>(recordType));
+					return 1;
+				}
+			}
+
+			// Only reached when a record was cut short, e.g. the process died before the final flush
+			std::cerr << "Binary log ends with a truncated record\n";
+			break;
+		}
+
+		// Threads append their buffers in chunks, so the file is only ordered per thread
+		std::ranges::stable_sort(lines, {}, &DecodedLine::TimestampNs);
+
+		for (const DecodedLine& line : lines)
+			output << line.Text << '\n';
+
+		std::cerr << std::format("Decoded {0} messages\n", lines.size());
+		return 0;
+	}
+}        // namespace
+
+int main(int argc, char** argv)
+{
+	std::string_view inputPath;
+	std::string_view outputPath;
+	bool             showSource = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view argument = argv[i];
+
+		if (argument == "--source")
+			showSource = true;
+		else if (inputPath.empty())
+			inputPath = argument;
+		else if (outputPath.empty())
+			outputPath = argument;
+	}
+
+	if (inputPath.empty())
+	{
+		std::cerr << "Usage: Eruption-LogDecoder <input> [output] [--source]\n";
+		return 1;
+	}
+
+	std::ifstream input(std::string(inputPath), std::ios::binary);
+	if (!input)
+	{
+		std::cerr << std::format("Failed to open '{0}'\n", inputPath);
+		return 1;
+	}
+
+	if (outputPath.empty())
+		return Decode(input, std::cout, showSource);
+
+	std::ofstream output{std::string(outputPath)};
+	if (!output)
+	{
+		std::cerr << std::format("Failed to open '{0}'\n", outputPath);
+		return 1;
+	}
+
+	return Decode(input, output, showSource);
+}
@@ -0,0 +1,417 @@
+#include "Eruption/Debug/TelemetryFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef ER_PLATFORM_LINUX
+#	include <cerrno>
+#	include <csignal>
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+// Live viewer for the shared memory telemetry published by Eruption::Telemetry. Attaches to a running engine,
+// waits for one to start otherwise, and prints a summary of every refresh interval.
+//
+// Usage: Eruption-TelemetryViewer [name] [--interval <ms>] [--top <count>]
+//     name        Shared memory object to read, /eruption-telemetry when omitted
+//     --interval  Refresh interval in milliseconds, 1000 when omitted
+//     --top       Number of zones listed, by time per frame, 20 when omitted
+
+namespace
+{
+	namespace Format = Eruption::TelemetryFormat;
+
+	struct Options
+	{
+		std::string Name       = Format::DefaultName;
+		uint32_t    IntervalMs = 1000;
+		uint32_t    TopZones   = 20;
+	};
+
+	struct ZoneStats
+	{
+		uint64_t Count   = 0;
+		int64_t  TotalNs = 0;
+		int64_t  MaxNs   = 0;
+	};
+
+	// Everything read during one refresh interval, budgets are kept across intervals
+	struct IntervalStats
+	{
+		std::unordered_map<std::string, ZoneStats> Zones;
+		std::vector<Format::FrameRecord>           Frames;
+		std::vector<Format::MemoryBudgetRecord>    Budgets;
+		uint64_t                                   Records = 0;
+		uint64_t                                   Dropped = 0;
+	};
+
+	enum class ReadResult : uint8_t
+	{
+		Complete = 0,
+		Pending,        // Claimed by a writer that has not finished, or not claimed yet
+		Overwritten
+	};
+
+	std::string FormatBytes(double bytes)
+	{
+		constexpr std::string_view UNITS[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+
+		size_t unit = 0;
+		while (std::abs(bytes) >= 1024.0 && unit + 1 < std::size(UNITS))
+		{
+			bytes /= 1024.0;
+			++unit;
+		}
+
+		return std::format("{0:.1f} {1}", bytes, UNITS[unit]);
+	}
+
+#ifdef ER_PLATFORM_LINUX
+	class Channel
+	{
+	public:
+		~Channel() { Close(); }
+
+		// Fails until an engine has created and initialized the segment
+		bool Open(const std::string& name)
+		{
+			const int file = shm_open(name.c_str(), O_RDONLY, 0);
+			if (file < 0)
+				return false;
+
+			struct stat status{};
+			if (fstat(file, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Format::Header))
+			{
+				close(file);
+				return false;
+			}
+
+			void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+			close(file);
+
+			if (mapping == MAP_FAILED)
+				return false;
+
+			m_Mapping = mapping;
+			m_Size    = static_cast<size_t>(status.st_size);
+
+			// The engine writes the magic last, see Telemetry::Open
+			const auto* header = static_cast<const Format::Header*>(mapping);
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (header->FileMagic != Format::Magic || header->FileVersion != Format::Version ||
+			    header->RecordSize != sizeof(Format::Record) || header->Capacity == 0 ||
+			    m_Size < Format::GetSegmentSize(header->Capacity))
+			{
+				Close();
+				return false;
+			}
+
+			m_Header  = header;
+			m_Records = reinterpret_cast<const Format::Record*>(header + 1);
+			m_Mask    = header->Capacity - 1;
+			return true;
+		}
+
+		void Close()
+		{
+			if (m_Mapping)
+				munmap(m_Mapping, m_Size);
+
+			m_Mapping = nullptr;
+			m_Header  = nullptr;
+			m_Records = nullptr;
+		}
+
+		// The engine unlinks the segment when it exits, a crash only shows up through the process ID
+		[[nodiscard]] bool IsWriterAlive() const
+		{
+			return kill(static_cast<pid_t>(m_Header->ProcessID), 0) == 0 || errno == EPERM;
+		}
+
+		[[nodiscard]] uint64_t GetWriteIndex() const { return m_Header->WriteIndex.load(std::memory_order_acquire); }
+		[[nodiscard]] uint32_t GetCapacity() const { return m_Header->Capacity; }
+		[[nodiscard]] uint32_t GetProcessID() const { return m_Header->ProcessID; }
+
+		ReadResult Read(uint64_t position, uint64_t& info, std::array<uint64_t, Format::PayloadWords>& words) const
+		{
+			const uint64_t        expected = position * 2 + 2;
+			const Format::Record& record   = m_Records[position & m_Mask];
+
+			const uint64_t before = record.Sequence.load(std::memory_order_acquire);
+			if (before < expected)
+				return ReadResult::Pending;
+			if (before > expected)
+				return ReadResult::Overwritten;
+
+			info = record.Info.load(std::memory_order_relaxed);
+			for (uint32_t i = 0; i < Format::PayloadWords; ++i)
+				words[i] = record.Payload[i].load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return record.Sequence.load(std::memory_order_relaxed) == expected ? ReadResult::Complete
+			                                                                   : ReadResult::Overwritten;
+		}
+
+	private:
+		void*                 m_Mapping = nullptr;
+		size_t                m_Size    = 0;
+		const Format::Header* m_Header  = nullptr;
+		const Format::Record* m_Records = nullptr;
+		uint64_t              m_Mask    = 0;
+	};
+
+	void Accumulate(IntervalStats& stats, uint64_t info, const std::array<uint64_t, Format::PayloadWords>& words)
+	{
+		++stats.Records;
+
+		switch (Format::GetType(info))
+		{
+			case Format::RecordType::Zone:
+			{
+				const auto zone = Format::LoadPayload<Format::ZoneRecord>(words);
+
+				const std::string_view name(zone.Name.data(), std::ranges::find(zone.Name, '\0'));
+				ZoneStats&             zoneStats = stats.Zones[std::string(name)];
+
+				++zoneStats.Count;
+				zoneStats.TotalNs += zone.DurationNs;
+				zoneStats.MaxNs = std::max(zoneStats.MaxNs, zone.DurationNs);
+				break;
+			}
+			case Format::RecordType::Frame:
+			{
+				stats.Frames.push_back(Format::LoadPayload<Format::FrameRecord>(words));
+				break;
+			}
+			case Format::RecordType::MemoryBudget:
+			{
+				const auto budget = Format::LoadPayload<Format::MemoryBudgetRecord>(words);
+				stats.Budgets.resize(budget.HeapCount);
+				if (budget.HeapIndex < stats.Budgets.size())
+					stats.Budgets[budget.HeapIndex] = budget;
+				break;
+			}
+			default: break;
+		}
+	}
+
+	void Print(const Options& options, const Channel& channel, const IntervalStats& stats)
+	{
+		std::string out;
+
+		// Redraw in place on a terminal, append when piped to a file
+		if (isatty(STDOUT_FILENO))
+			out.append("\x1b[H\x1b[2J");
+		else
+			out.append("\n");
+
+		out.append(std::format("Eruption telemetry {0}, process {1}\n\n", options.Name, channel.GetProcessID()));
+
+		const double frameCount = static_cast<double>(std::max<size_t>(stats.Frames.size(), 1));
+
+		if (!stats.Frames.empty())
+		{
+			int64_t frameNs = 0;
+			int64_t maxNs   = 0;
+			int64_t cpuNs   = 0;
+			for (const Format::FrameRecord& frame : stats.Frames)
+			{
+				frameNs += frame.FrameTimeNs;
+				maxNs = std::max(maxNs, frame.FrameTimeNs);
+				cpuNs += frame.CpuTimeNs;
+			}
+
+			const Format::FrameRecord& last = stats.Frames.back();
+
+			out.append(std::format(
+			    "Frames      {0} (last {1}), {2:.2f} ms average, {3:.2f} ms max, {4:.2f} ms CPU\n",
+			    stats.Frames.size(),
+			    last.FrameIndex,
+			    static_cast<double>(frameNs) * 1e-6 / frameCount,
+			    static_cast<double>(maxNs) * 1e-6,
+			    static_cast<double>(cpuNs) * 1e-6 / frameCount
+			));
+			out.append(std::format(
+			    "Heap        {0} live, {1} allocations in the last frame\n",
+			    FormatBytes(static_cast<double>(last.HeapLiveBytes)),
+			    last.HeapAllocations
+			));
+			out.append(std::format("GPU memory  {0} live\n", FormatBytes(static_cast<double>(last.GpuLiveBytes))));
+		}
+		else
+		{
+			out.append("No frames in this interval\n");
+		}
+
+		if (!stats.Budgets.empty())
+		{
+			out.append("\nHeap   Usage / Budget                 Blocks        Allocations\n");
+			for (const Format::MemoryBudgetRecord& budget : stats.Budgets)
+			{
+				const double percent =
+				    budget.Budget ? static_cast<double>(budget.Usage) * 100.0 / static_cast<double>(budget.Budget) : 0;
+
+				out.append(std::format(
+				    "{0:<6} {1:>10} / {2:<10} {3:>4.0f}%  {4:>12}  {5:>12}\n",
+				    budget.HeapIndex,
+				    FormatBytes(static_cast<double>(budget.Usage)),
+				    FormatBytes(static_cast<double>(budget.Budget)),
+				    percent,
+				    FormatBytes(static_cast<double>(budget.BlockBytes)),
+				    FormatBytes(static_cast<double>(budget.AllocationBytes))
+				));
+			}
+		}
+
+		std::vector<std::pair<std::string_view, ZoneStats>> zones(stats.Zones.begin(), stats.Zones.end());
+		std::ranges::sort(zones, std::greater{}, [](const auto& zone) { return zone.second.TotalNs; });
+		zones.resize(std::min<size_t>(zones.size(), options.TopZones));
+
+		out.append(std::format(
+		    "\n{0:<32} {1:>12} {2:>12} {3:>10}\n", "Zone", "Calls/frame", "ms/frame", "Max ms"
+		));
+		for (const auto& [name, zoneStats] : zones)
+		{
+			out.append(std::format(
+			    "{0:<32} {1:>12.1f} {2:>12.3f} {3:>10.3f}\n",
+			    name,
+			    static_cast<double>(zoneStats.Count) / frameCount,
+			    static_cast<double>(zoneStats.TotalNs) * 1e-6 / frameCount,
+			    static_cast<double>(zoneStats.MaxNs) * 1e-6
+			));
+		}
+
+		out.append(std::format("\n{0} records, {1} lost to overruns\n", stats.Records, stats.Dropped));
+
+		std::fwrite(out.data(), 1, out.size(), stdout);
+		std::fflush(stdout);
+	}
+
+	int Run(const Options& options)
+	{
+		Channel channel;
+
+		std::cerr << std::format("Waiting for {0}\n", options.Name);
+
+		while (true)
+		{
+			while (!channel.Open(options.Name))
+				std::this_thread::sleep_for(std::chrono::milliseconds(options.IntervalMs));
+
+			std::cerr << std::format("Attached to process {0}\n", channel.GetProcessID());
+
+			// Only records published from now on, the backlog in the ring could be minutes old
+			uint64_t cursor  = channel.GetWriteIndex();
+			uint64_t pending = UINT64_MAX;
+
+			std::vector<Format::MemoryBudgetRecord> budgets;
+
+			while (channel.IsWriterAlive())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(options.IntervalMs));
+
+				IntervalStats stats;
+				stats.Budgets = std::move(budgets);
+
+				const uint64_t writeIndex = channel.GetWriteIndex();
+				if (writeIndex - cursor > channel.GetCapacity())
+				{
+					stats.Dropped += writeIndex - cursor - channel.GetCapacity();
+					cursor = writeIndex - channel.GetCapacity();
+				}
+
+				uint64_t                                   info = 0;
+				std::array<uint64_t, Format::PayloadWords> words{};
+
+				for (; cursor < writeIndex; ++cursor)
+				{
+					const ReadResult result = channel.Read(cursor, info, words);
+					if (result == ReadResult::Complete)
+					{
+						Accumulate(stats, info, words);
+						continue;
+					}
+
+					// A slot still incomplete a whole interval later belongs to a writer that will not finish
+					if (result == ReadResult::Pending && cursor != pending)
+					{
+						pending = cursor;
+						break;
+					}
+
+					++stats.Dropped;
+				}
+
+				Print(options, channel, stats);
+				budgets = std::move(stats.Budgets);
+			}
+
+			std::cerr << std::format("Process {0} exited, waiting for {1}\n", channel.GetProcessID(), options.Name);
+			channel.Close();
+		}
+	}
+#endif
+
+	bool ParseNumber(std::string_view text, uint32_t& value)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc() && end == text.data() + text.size() && value > 0;
+	}
+}        // namespace
+
+int main(int argc, char** argv)
+{
+	Options options;
+	bool    nameSet = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view argument = argv[i];
+
+		if ((argument == "--interval" || argument == "--top") && i + 1 < argc)
+		{
+			uint32_t& value = argument == "--interval" ? options.IntervalMs : options.TopZones;
+			if (!ParseNumber(argv[++i], value))
+			{
+				std::cerr << std::format("Invalid value '{0}' for {1}\n", argv[i], argument);
+				return 1;
+			}
+		}
+		else if (!nameSet && !argument.starts_with("--"))
+		{
+			options.Name = argument;
+			nameSet      = true;
+		}
+		else
+		{
+			std::cerr << "Usage: Eruption-TelemetryViewer [name] [--interval <ms>] [--top <count>]\n";
+			return 1;
+		}
+	}
+
+#ifdef ER_PLATFORM_LINUX
+	return Run(options);
+#else
+	std::cerr << "The telemetry channel needs POSIX shared memory, not available on this platform\n";
+	return 1;
+#endif
+}